@@ -0,0 +1,289 @@
+#include "AdaptiveDepthEstimator.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+namespace {
+
+// Smoothing of the measured latency; about the last eight inferences count
+const double kSmoothing = 0.25;
+
+// Frames to wait after a switch before stepping down again, and before stepping up
+const int kDownHoldFrames = 5;
+const int kUpHoldFrames = 30;
+
+// Step up only with this much headroom, so one slow frame doesn't bounce us straight back
+const double kUpHeadroom = 0.8;
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+AdaptiveDepthEstimator::AdaptiveDepthEstimator(const std::vector<Level>& levels, double budgetMs)
+    : requestedLevels(levels)
+    , initialized(false)
+    , autoSelectBackend(false)
+    , budgetMs(budgetMs)
+    , smoothedMs(0.0)
+    , framesSinceSwitch(0)
+    , currentLevel(0)
+    , switchCount(0)
+    , frameCount(0) {
+}
+
+std::vector<AdaptiveDepthEstimator::Level> AdaptiveDepthEstimator::defaultLevels(const std::string& smallModelPath,
+                                                                                const std::string& largeModelPath) {
+    std::vector<Level> levels;
+    levels.push_back(Level("small 128", smallModelPath, cv::Size(128, 128)));
+    levels.push_back(Level("small 192", smallModelPath, cv::Size(192, 192)));
+    levels.push_back(Level("small 256", smallModelPath, cv::Size(256, 256)));
+    if (!largeModelPath.empty()) {
+        levels.push_back(Level("large 384", largeModelPath, cv::Size(384, 384)));
+    }
+    return levels;
+}
+
+bool AdaptiveDepthEstimator::initialize(const std::string& modelPath) {
+    levels.clear();
+    estimators.clear();
+    initialized = false;
+    
+    // Load each model file once; levels on the same model share it
+    for (const Level& requested : requestedLevels) {
+        Level level = requested;
+        if (level.modelPath.empty()) {
+            level.modelPath = modelPath;
+        }
+        
+        std::unique_ptr<DepthEstimator>& estimator = estimators[level.modelPath];
+        if (!estimator) {
+            estimator = std::unique_ptr<DepthEstimator>(new DepthEstimator());
+            estimator->setAutoSelectBackend(autoSelectBackend);
+            if (!estimator->initialize(level.modelPath)) {
+                std::cerr << "⚠️  Depth quality level " << level.name << " unavailable: could not load " << level.modelPath << std::endl;
+                continue;
+            }
+        }
+        if (!estimator->isInitialized()) {
+            continue;
+        }
+        
+        LevelState state(level);
+        state.estimator = estimator.get();
+        levels.push_back(state);
+    }
+    
+    // Time every level on the same frame; that's what tells the levels apart
+    const cv::Mat testFrame = DepthEstimator::makeTestFrame();
+    std::vector<LevelState> usable;
+    for (LevelState& state : levels) {
+        state.calibratedMs = calibrate(state, testFrame);
+        if (state.calibratedMs > 0.0) {
+            std::cout << "Depth quality level " << state.level.name << ": " << state.calibratedMs << " ms" << std::endl;
+            usable.push_back(state);
+        } else {
+            std::cerr << "⚠️  Depth quality level " << state.level.name << " dropped: model can't run at "
+                      << state.level.inputSize.width << "x" << state.level.inputSize.height << std::endl;
+        }
+    }
+    levels.swap(usable);
+    
+    if (levels.empty()) {
+        std::cerr << "❌ Error: No usable depth quality level" << std::endl;
+        return false;
+    }
+    
+    // Start at the best level that fits the budget, or the cheapest if none does
+    int start = 0;
+    for (size_t i = 0; i < levels.size(); i++) {
+        if (levels[i].calibratedMs <= budgetMs * kUpHeadroom) {
+            start = static_cast<int>(i);
+        }
+    }
+    activate(start);
+    currentLevel = start;
+    smoothedMs = levels[start].calibratedMs;
+    framesSinceSwitch = 0;
+    initialized = true;
+    
+    std::cout << "✅ Adaptive depth quality: " << levels.size() << " level(s), budget " << budgetMs
+              << " ms, starting at " << levels[start].level.name << std::endl;
+    return true;
+}
+
+double AdaptiveDepthEstimator::calibrate(LevelState& state, const cv::Mat& testFrame) {
+    if (!state.estimator->setInputSize(state.level.inputSize)) {
+        return 0.0;
+    }
+    
+    // One warm-up pass (allocates the layers for this input size), then the best of three
+    FramePacket packet;
+    packet.image = testFrame;
+    cv::Mat depthMap;
+    if (!state.estimator->estimateDepth(packet, depthMap)) {
+        return 0.0;
+    }
+    
+    double best = 0.0;
+    for (int i = 0; i < 3; i++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (!state.estimator->estimateDepth(packet, depthMap)) {
+            return 0.0;
+        }
+        double elapsed = millisecondsSince(start);
+        best = (i == 0) ? elapsed : std::min(best, elapsed);
+    }
+    return best;
+}
+
+void AdaptiveDepthEstimator::activate(int level) {
+    levels[level].estimator->setInputSize(levels[level].level.inputSize);
+}
+
+cv::Mat AdaptiveDepthEstimator::estimateDepth(const cv::Mat& inputImage) {
+    FramePacket packet;
+    packet.image = inputImage;
+    return estimateDepth(packet);
+}
+
+cv::Mat AdaptiveDepthEstimator::estimateDepth(FramePacket& packet) {
+    cv::Mat depthMap;
+    estimateDepth(packet, depthMap);
+    return depthMap;
+}
+
+bool AdaptiveDepthEstimator::estimateDepth(FramePacket& packet, cv::Mat& depthMap) {
+    if (!initialized) {
+        return false;
+    }
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool ok = levels[currentLevel].estimator->estimateDepth(packet, depthMap);
+    if (ok) {
+        recordLatency(millisecondsSince(start));
+    }
+    return ok;
+}
+
+std::vector<cv::Mat> AdaptiveDepthEstimator::estimateDepthBatch(std::vector<FramePacket>& packets) {
+    if (!initialized || packets.empty()) {
+        return std::vector<cv::Mat>(packets.size());
+    }
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<cv::Mat> depthMaps = levels[currentLevel].estimator->estimateDepthBatch(packets);
+    recordLatency(millisecondsSince(start) / packets.size());
+    return depthMaps;
+}
+
+void AdaptiveDepthEstimator::recordLatency(double latencyMs) {
+    LevelState& state = levels[currentLevel];
+    state.frames++;
+    frameCount++;
+    framesSinceSwitch++;
+    smoothedMs += kSmoothing * (latencyMs - smoothedMs);
+    
+    const int level = currentLevel;
+    if (smoothedMs > budgetMs && level > 0 && framesSinceSwitch >= kDownHoldFrames) {
+        // Over budget: drop to the best level predicted to fit, not just one step,
+        // so a sudden load spike is fixed in one switch
+        int target = 0;
+        for (int i = level - 1; i > 0; i--) {
+            if (predictLatency(i) <= budgetMs) {
+                target = i;
+                break;
+            }
+        }
+        switchTo(target, "over budget");
+    } else if (level + 1 < static_cast<int>(levels.size()) && framesSinceSwitch >= kUpHoldFrames &&
+               predictLatency(level + 1) <= budgetMs * kUpHeadroom) {
+        // Sustained headroom: one step up at a time
+        switchTo(level + 1, "headroom");
+    }
+}
+
+double AdaptiveDepthEstimator::predictLatency(int level) const {
+    // The current level's slowdown against its startup timing applies to the whole ladder
+    const LevelState& current = levels[currentLevel];
+    const double load = smoothedMs / current.calibratedMs;
+    return levels[level].calibratedMs * load;
+}
+
+void AdaptiveDepthEstimator::switchTo(int level, const std::string& reason) {
+    const int from = currentLevel;
+    
+    SwitchEvent event;
+    event.fromLevel = from;
+    event.toLevel = level;
+    event.fromName = levels[from].level.name;
+    event.toName = levels[level].level.name;
+    event.latencyMs = smoothedMs;
+    event.budgetMs = budgetMs;
+    event.reason = reason;
+    event.frameIndex = frameCount;
+    
+    // Carry the current load over so the new level is judged on a sensible starting estimate
+    smoothedMs = predictLatency(level);
+    activate(level);
+    currentLevel = level;
+    framesSinceSwitch = 0;
+    switchCount++;
+    
+    std::cout << "Depth quality " << event.fromName << " -> " << event.toName << " (" << reason << ", "
+              << event.latencyMs << " ms against " << budgetMs << " ms budget)" << std::endl;
+    if (switchCallback) {
+        switchCallback(event);
+    }
+}
+
+uint64_t AdaptiveDepthEstimator::getLastFrameAllocationCount() const {
+    if (!initialized) {
+        return 0;
+    }
+    return levels[currentLevel].estimator->getLastFrameAllocationCount();
+}
+
+cv::Mat AdaptiveDepthEstimator::createDepthHeatMap(const cv::Mat& depthMap) {
+    if (!initialized) {
+        return cv::Mat();
+    }
+    return levels[currentLevel].estimator->createDepthHeatMap(depthMap);
+}
+
+cv::Mat AdaptiveDepthEstimator::overlayDepthHeatMap(const cv::Mat& originalImage, const cv::Mat& depthMap, float alpha) {
+    if (!initialized) {
+        return originalImage;
+    }
+    return levels[currentLevel].estimator->overlayDepthHeatMap(originalImage, depthMap, alpha);
+}
+
+void AdaptiveDepthEstimator::blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) {
+    if (initialized) {
+        levels[currentLevel].estimator->blendDepthHeatMap(depthMap, alpha, frame);
+    }
+}
+
+std::string AdaptiveDepthEstimator::getDescription() const {
+    if (!initialized) {
+        return "Adaptive depth (not initialized)";
+    }
+    return levels[currentLevel].estimator->getDescription() + " (adaptive, " + getCurrentLevelName() + ")";
+}
+
+std::string AdaptiveDepthEstimator::getCurrentLevelName() const {
+    if (!initialized) {
+        return "";
+    }
+    return levels[currentLevel].level.name;
+}
+
+std::string AdaptiveDepthEstimator::summary() const {
+    std::ostringstream out;
+    out << "Depth quality switched " << switchCount << " time(s), budget " << budgetMs << " ms";
+    for (const LevelState& state : levels) {
+        out << "; " << state.level.name << ": " << state.frames << " frame(s)";
+    }
+    return out.str();
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "IDepthEstimator.h"
+#include "DepthEstimator.h"
+
+/**
+ * Holds depth inference inside a latency budget by switching model and input resolution
+ * at runtime.
+ * The estimator works down a ladder of quality levels (for example the small model at
+ * 128, 192 and 256 pixels, and the large model at 384 when it's available). Every level
+ * is timed once at startup, which gives its relative cost. While running, the measured
+ * latency of the current level tells how loaded the machine is, and with the relative
+ * costs that predicts what every other level would take now. When the smoothed latency
+ * goes over budget the estimator drops to the best level predicted to fit; when there has
+ * been clear headroom for a while it steps up one level. Each change is reported as a
+ * SwitchEvent.
+ * The budget applies to each inference pass, so region refinement in front of this
+ * estimator gets cheaper along with the full frame.
+ */
+class AdaptiveDepthEstimator : public IDepthEstimator {
+public:
+    // One rung of the quality ladder
+    struct Level {
+        std::string name;
+        std::string modelPath;  // Empty: the path passed to initialize()
+        cv::Size inputSize;
+        
+        Level(const std::string& name, const std::string& modelPath, cv::Size inputSize)
+            : name(name), modelPath(modelPath), inputSize(inputSize) {}
+    };
+    
+    // A change of quality level
+    struct SwitchEvent {
+        int fromLevel;
+        int toLevel;
+        std::string fromName;
+        std::string toName;
+        double latencyMs;    // Smoothed latency that triggered the switch
+        double budgetMs;
+        std::string reason;
+        uint64_t frameIndex;  // Frames estimated before the switch
+    };
+    typedef std::function<void(const SwitchEvent&)> SwitchCallback;
+    
+    /**
+     * @param levels Quality levels, cheapest first
+     * @param budgetMs Target latency of one depth inference
+     */
+    AdaptiveDepthEstimator(const std::vector<Level>& levels, double budgetMs);
+    
+    /**
+     * The default ladder: the small MiDaS model at 128, 192 and 256 pixels, then the large
+     * model at 384 pixels if `largeModelPath` is not empty.
+     */
+    static std::vector<Level> defaultLevels(const std::string& smallModelPath, const std::string& largeModelPath);
+    
+    // Called on the inference thread for every switch (set before estimating)
+    void setSwitchCallback(SwitchCallback callback) { switchCallback = callback; }
+    
+    // Benchmark DNN configurations for each model at startup (call before initialize())
+    void setAutoSelectBackend(bool enabled) { autoSelectBackend = enabled; }
+    
+    void setLatencyBudgetMs(double budget) { budgetMs = budget; }
+    double getLatencyBudgetMs() const { return budgetMs; }
+    
+    // Load every model, time every level and start at the best one that fits the budget.
+    // Levels the model can't run (e.g. a fixed input size) are dropped.
+    bool initialize(const std::string& modelPath = "") override;
+    
+    cv::Mat estimateDepth(const cv::Mat& inputImage) override;
+    cv::Mat estimateDepth(FramePacket& packet) override;
+    bool estimateDepth(FramePacket& packet, cv::Mat& depthMap) override;
+    
+    // The batch is estimated at the current level; its latency per frame counts against the budget
+    std::vector<cv::Mat> estimateDepthBatch(std::vector<FramePacket>& packets) override;
+    
+    uint64_t getLastFrameAllocationCount() const override;
+    
+    cv::Mat createDepthHeatMap(const cv::Mat& depthMap) override;
+    cv::Mat overlayDepthHeatMap(const cv::Mat& originalImage, const cv::Mat& depthMap, float alpha = 0.6f) override;
+    void blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) override;
+    
+    bool isInitialized() const override { return initialized; }
+    std::string getDescription() const override;
+    
+    // Current level (safe to call from any thread)
+    int getCurrentLevel() const { return currentLevel; }
+    std::string getCurrentLevelName() const;
+    uint64_t getSwitchCount() const { return switchCount; }
+    std::string summary() const;
+
+private:
+    struct LevelState {
+        Level level;
+        DepthEstimator* estimator;  // Owned by `estimators`
+        double calibratedMs;        // Latency measured at startup: the level's relative cost
+        uint64_t frames;
+        
+        LevelState(const Level& level) : level(level), estimator(nullptr), calibratedMs(0.0), frames(0) {}
+    };
+    
+    std::vector<Level> requestedLevels;
+    std::vector<LevelState> levels;
+    std::map<std::string, std::unique_ptr<DepthEstimator>> estimators;  // One per model file
+    bool initialized;
+    bool autoSelectBackend;
+    
+    // Controller state
+    double budgetMs;
+    double smoothedMs;        // Latency of the current level, exponentially smoothed
+    int framesSinceSwitch;
+    std::atomic<int> currentLevel;
+    std::atomic<uint64_t> switchCount;
+    uint64_t frameCount;
+    SwitchCallback switchCallback;
+    
+    // Time a level on the test frame; 0 if the model can't run it
+    double calibrate(LevelState& state, const cv::Mat& testFrame);
+    
+    // Point the level's estimator at its input size
+    void activate(int level);
+    
+    // Feed one measured latency to the controller and switch levels if needed
+    void recordLatency(double latencyMs);
+    
+    // Latency `level` would have right now, judging by how the current level is doing
+    double predictLatency(int level) const;
+    
+    void switchTo(int level, const std::string& reason);
+};
@@ -0,0 +1,75 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <mutex>
+
+namespace {
+
+thread_local uint64_t threadAllocations = 0;
+thread_local uint64_t threadBytes = 0;
+std::atomic<uint64_t> processAllocations(0);
+std::atomic<uint64_t> processBytes(0);
+
+AllocationCounter* installedCounter = nullptr;
+std::mutex installMutex;
+
+}
+
+AllocationCounter::AllocationCounter(cv::MatAllocator* wrapped)
+    : wrapped(wrapped) {
+}
+
+void AllocationCounter::install() {
+    std::lock_guard<std::mutex> lock(installMutex);
+    if (installedCounter) {
+        return;
+    }
+    
+    // Never freed: Mats allocated through it may outlive any owner we could give it
+    installedCounter = new AllocationCounter(cv::Mat::getDefaultAllocator());
+    cv::Mat::setDefaultAllocator(installedCounter);
+}
+
+bool AllocationCounter::isInstalled() {
+    std::lock_guard<std::mutex> lock(installMutex);
+    return installedCounter != nullptr;
+}
+
+uint64_t AllocationCounter::threadAllocationCount() {
+    return threadAllocations;
+}
+
+uint64_t AllocationCounter::threadAllocatedBytes() {
+    return threadBytes;
+}
+
+uint64_t AllocationCounter::processAllocationCount() {
+    return processAllocations;
+}
+
+uint64_t AllocationCounter::processAllocatedBytes() {
+    return processBytes;
+}
+
+cv::UMatData* AllocationCounter::allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                                          cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const {
+    // Wrapping caller-owned memory doesn't allocate a buffer
+    if (!data) {
+        size_t bytes = CV_ELEM_SIZE(type);
+        for (int i = 0; i < dims; i++) {
+            bytes *= static_cast<size_t>(sizes[i]);
+        }
+        threadAllocations++;
+        threadBytes += bytes;
+        processAllocations++;
+        processBytes += bytes;
+    }
+    return wrapped->allocate(dims, sizes, type, data, step, flags, usageFlags);
+}
+
+bool AllocationCounter::allocate(cv::UMatData* data, cv::AccessFlag accessFlags, cv::UMatUsageFlags usageFlags) const {
+    return wrapped->allocate(data, accessFlags, usageFlags);
+}
+
+void AllocationCounter::deallocate(cv::UMatData* data) const {
+    wrapped->deallocate(data);
+}
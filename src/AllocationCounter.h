@@ -0,0 +1,43 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+
+/**
+ * cv::Mat allocator that counts buffer allocations per thread and for the whole process.
+ * Once installed it wraps the default allocator, so every Mat created afterwards is
+ * counted on the thread that allocated it and in the process totals. Comparing the
+ * thread counts before and after a call shows the buffers that call allocated on the
+ * calling thread; the process counts also cover helper threads it fans out to
+ * (cv::parallel_for_, the TaskScheduler, DNN layers), but include anything other
+ * threads allocate meanwhile, so they are exact only while the call runs alone.
+ * Only cv::Mat buffers are counted: other heap allocations (std::vector, strings,
+ * DNN internals that don't go through Mat) are invisible to it.
+ */
+class AllocationCounter : public cv::MatAllocator {
+public:
+    /**
+     * Make the counter the default Mat allocator. Call once at startup, before
+     * creating the Mats to be measured; later calls do nothing.
+     */
+    static void install();
+    static bool isInstalled();
+    
+    // Buffers and bytes allocated on the calling thread since it started
+    static uint64_t threadAllocationCount();
+    static uint64_t threadAllocatedBytes();
+    
+    // Buffers and bytes allocated on any thread since install()
+    static uint64_t processAllocationCount();
+    static uint64_t processAllocatedBytes();
+    
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                           cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override;
+    bool allocate(cv::UMatData* data, cv::AccessFlag accessFlags, cv::UMatUsageFlags usageFlags) const override;
+    void deallocate(cv::UMatData* data) const override;
+
+private:
+    explicit AllocationCounter(cv::MatAllocator* wrapped);
+    
+    cv::MatAllocator* wrapped;
+};
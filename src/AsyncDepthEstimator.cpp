@@ -0,0 +1,252 @@
+#include "AsyncDepthEstimator.h"
+#include <iostream>
+
+namespace {
+
+// Times a blocking estimate is resubmitted after newer frames displace it
+const int kMaxBlockingAttempts = 3;
+
+}
+
+AsyncDepthEstimator::AsyncDepthEstimator(std::unique_ptr<IDepthEstimator> estimator)
+    : estimator(std::move(estimator))
+    , hasPending(false)
+    , accepting(false)
+    , taskQueued(false)
+    , hasLatestResult(false)
+    , resultPool(3)
+    , resultType(CV_32F)
+    , completedCount(0)
+    , cancelledCount(0) {
+    if (this->estimator->isInitialized()) {
+        start();
+    }
+}
+
+AsyncDepthEstimator::~AsyncDepthEstimator() {
+    stop();
+}
+
+bool AsyncDepthEstimator::initialize(const std::string& modelPath) {
+    stop();
+    if (!estimator->initialize(modelPath)) {
+        return false;
+    }
+    start();
+    return true;
+}
+
+void AsyncDepthEstimator::start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    accepting = true;
+}
+
+void AsyncDepthEstimator::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        accepting = false;
+    }
+    
+    // Let the running request finish; a queued task sees we stopped and does nothing
+    TaskScheduler::shared().wait(tasks);
+    
+    // Nothing will pick up a request queued after we stopped
+    Request abandoned;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (hasPending) {
+            abandoned = pending;
+            pending = Request();
+            hasPending = false;
+        }
+    }
+    if (abandoned.promise) {
+        finish(abandoned, true);
+        cancelledCount++;
+    }
+}
+
+DepthFuture AsyncDepthEstimator::submit(const FramePacket& packet) {
+    std::shared_ptr<std::promise<DepthResult>> promise = std::make_shared<std::promise<DepthResult>>();
+    DepthFuture future = promise->get_future().share();
+    enqueue(packet, promise, DepthCallback());
+    return future;
+}
+
+void AsyncDepthEstimator::submit(const FramePacket& packet, DepthCallback callback) {
+    enqueue(packet, std::make_shared<std::promise<DepthResult>>(), callback);
+}
+
+void AsyncDepthEstimator::enqueue(const FramePacket& packet, std::shared_ptr<std::promise<DepthResult>> promise, DepthCallback callback) {
+    Request replaced;
+    bool running;
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = accepting;
+        if (running) {
+            if (hasPending) {
+                replaced = pending;
+            }
+            pending.packet = packet;
+            pending.promise = promise;
+            pending.callback = callback;
+            hasPending = true;
+            
+            // A task already queued or running will get to this request
+            schedule = !taskQueued;
+            taskQueued = true;
+        }
+    }
+    
+    if (!running) {
+        // Not initialized: complete straight away with an empty result
+        Request rejected;
+        rejected.packet = packet;
+        rejected.promise = promise;
+        rejected.callback = callback;
+        finish(rejected, false);
+        return;
+    }
+    
+    if (schedule) {
+        TaskScheduler::shared().submit(TaskScheduler::PRIORITY_HIGH, [this]() { runPending(); }, &tasks);
+    }
+    
+    // The frame we displaced never started; let its waiter know outside the lock
+    if (replaced.promise) {
+        finish(replaced, true);
+        cancelledCount++;
+    }
+}
+
+void AsyncDepthEstimator::finish(Request& request, bool cancelled) {
+    DepthResult result;
+    result.sequence = request.packet.sequence;
+    result.sourceId = request.packet.sourceId;
+    result.captureTimeNs = request.packet.captureTimeNs();
+    result.cancelled = cancelled;
+    
+    request.promise->set_value(result);
+    if (request.callback) {
+        request.callback(result);
+    }
+}
+
+void AsyncDepthEstimator::runPending() {
+    Request request;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!accepting || !hasPending) {
+            taskQueued = false;
+            return;
+        }
+        request = pending;
+        pending = Request();
+        hasPending = false;
+    }
+    
+    // Estimate into a pooled buffer: it returns to the pool once every holder of the result lets go
+    DepthResult result;
+    if (resultSize.area() > 0) {
+        result.depthMap = resultPool.acquire(resultSize, resultType);
+    }
+    if (estimator->estimateDepth(request.packet, result.depthMap)) {
+        resultSize = result.depthMap.size();
+        resultType = result.depthMap.type();
+    } else {
+        result.depthMap.release();
+    }
+    result.sequence = request.packet.sequence;
+    result.sourceId = request.packet.sourceId;
+    result.captureTimeNs = request.packet.captureTimeNs();
+    
+    // The request's frame buffer goes back to the capture pool as soon as we're done with it
+    request.packet.image.release();
+    
+    // A frame that arrived meanwhile gets a task of its own rather than this one looping,
+    // so work queued at the same priority isn't held up behind a stream of frames
+    bool again;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!result.depthMap.empty()) {
+            latestResult = result;
+            hasLatestResult = true;
+        }
+        again = accepting && hasPending;
+        taskQueued = again;
+    }
+    completedCount++;
+    
+    request.promise->set_value(result);
+    if (request.callback) {
+        request.callback(result);
+    }
+    if (again) {
+        TaskScheduler::shared().submit(TaskScheduler::PRIORITY_HIGH, [this]() { runPending(); }, &tasks);
+    }
+}
+
+bool AsyncDepthEstimator::getLatestResult(DepthResult& result) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasLatestResult) {
+        return false;
+    }
+    result = latestResult;
+    return true;
+}
+
+cv::Mat AsyncDepthEstimator::estimateDepth(const cv::Mat& inputImage) {
+    FramePacket packet;
+    packet.image = inputImage;
+    
+    // Wait for this frame specifically; if a newer submission displaces it, submit it again,
+    // but not forever: a steady stream of frames from other callers could displace it every time.
+    // Waiting on the task group runs the request here if no worker has taken it yet, so a
+    // task of the scheduler can block on it without starving the pool.
+    DepthResult result;
+    for (int attempt = 0; attempt < kMaxBlockingAttempts; attempt++) {
+        DepthFuture future = submit(packet);
+        TaskScheduler::shared().wait(tasks);
+        result = future.get();
+        if (!result.cancelled) {
+            return result.depthMap;
+        }
+    }
+    
+    std::cerr << "⚠️  Depth request displaced by newer frames " << kMaxBlockingAttempts << " times; giving up" << std::endl;
+    return cv::Mat();
+}
+
+cv::Mat AsyncDepthEstimator::estimateDepth(FramePacket& packet) {
+    submit(packet);
+    
+    DepthResult result;
+    if (!getLatestResult(result)) {
+        return cv::Mat();
+    }
+    return result.depthMap;
+}
+
+bool AsyncDepthEstimator::estimateDepth(FramePacket& packet, cv::Mat& depthMap) {
+    submit(packet);
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasLatestResult) {
+        return false;
+    }
+    latestResult.depthMap.copyTo(depthMap);
+    return true;
+}
+
+cv::Mat AsyncDepthEstimator::createDepthHeatMap(const cv::Mat& depthMap) {
+    return estimator->createDepthHeatMap(depthMap);
+}
+
+cv::Mat AsyncDepthEstimator::overlayDepthHeatMap(const cv::Mat& originalImage, const cv::Mat& depthMap, float alpha) {
+    return estimator->overlayDepthHeatMap(originalImage, depthMap, alpha);
+}
+
+void AsyncDepthEstimator::blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) {
+    estimator->blendDepthHeatMap(depthMap, alpha, frame);
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include "IDepthEstimator.h"
+#include "FramePool.h"
+#include "TaskScheduler.h"
+
+// Outcome of an asynchronous depth request
+struct DepthResult {
+    cv::Mat depthMap;       // Empty if the request was cancelled or inference failed
+    uint64_t sequence = 0;  // Sequence number of the frame the depth belongs to
+    int sourceId = 0;
+    int64_t captureTimeNs = 0;
+    bool cancelled = false; // Replaced by a newer frame before it started
+};
+
+typedef std::shared_future<DepthResult> DepthFuture;
+typedef std::function<void(const DepthResult&)> DepthCallback;
+
+/**
+ * Runs another depth estimator in the background, as high-priority tasks of the shared
+ * TaskScheduler: one task per frame, so other work gets a turn between frames, and never
+ * more than one at a time, since the wrapped estimator isn't reentrant.
+ * submit() returns immediately with a future (or calls back when done). Only one request
+ * waits behind the one being processed: a newer submission replaces a queued one that
+ * hasn't started, which completes as cancelled, so inference is never spent on stale frames.
+ *
+ * The packet overload of estimateDepth() is non-blocking: it queues the frame and returns
+ * the most recent finished depth map (possibly from an earlier frame), so a render loop
+ * keeps its own rate while depth updates as fast as inference allows. The Mat overload
+ * waits for its result, resubmitting a few times if newer frames displace it.
+ */
+class AsyncDepthEstimator : public IDepthEstimator {
+public:
+    // Takes ownership of `estimator`; accepts requests once it is initialized
+    explicit AsyncDepthEstimator(std::unique_ptr<IDepthEstimator> estimator);
+    ~AsyncDepthEstimator() override;
+    
+    // Initialize the wrapped estimator and start accepting requests
+    bool initialize(const std::string& modelPath = "") override;
+    
+    // Queue a frame for depth estimation, replacing any queued frame that hasn't started
+    DepthFuture submit(const FramePacket& packet);
+    
+    // As above, but call `callback` on the scheduler's thread when the request completes or is cancelled
+    void submit(const FramePacket& packet, DepthCallback callback);
+    
+    // Most recent completed depth map; false until the first one is ready
+    bool getLatestResult(DepthResult& result) const;
+    
+    // Estimate depth and wait for the result; empty if newer frames keep displacing the request
+    cv::Mat estimateDepth(const cv::Mat& inputImage) override;
+    
+    // Queue the packet and return the latest finished depth map without waiting
+    cv::Mat estimateDepth(FramePacket& packet) override;
+    
+    // Copy the latest finished depth map into `depthMap` after queueing the packet
+    bool estimateDepth(FramePacket& packet, cv::Mat& depthMap) override;
+    
+    uint64_t getLastFrameAllocationCount() const override { return estimator->getLastFrameAllocationCount(); }
+    
+    // Heat map helpers don't touch inference state, so they run on the caller's thread
+    cv::Mat createDepthHeatMap(const cv::Mat& depthMap) override;
+    cv::Mat overlayDepthHeatMap(const cv::Mat& originalImage, const cv::Mat& depthMap, float alpha = 0.6f) override;
+    void blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) override;
+    
+    bool isInitialized() const override { return estimator->isInitialized(); }
+    std::string getDescription() const override { return estimator->getDescription() + " (async)"; }
+    
+    // Requests run to completion, and requests replaced before they started
+    uint64_t getCompletedCount() const { return completedCount; }
+    uint64_t getCancelledCount() const { return cancelledCount; }
+    
+private:
+    struct Request {
+        FramePacket packet;
+        std::shared_ptr<std::promise<DepthResult>> promise;
+        DepthCallback callback;
+    };
+    
+    std::unique_ptr<IDepthEstimator> estimator;
+    
+    mutable std::mutex mutex;
+    Request pending;
+    bool hasPending;
+    bool accepting;    // Initialized and not stopped
+    bool taskQueued;   // A task is queued or running; it takes `pending`
+    DepthResult latestResult;
+    bool hasLatestResult;
+    
+    // Depth maps handed out in results; only the running task touches the geometry
+    FramePool resultPool;
+    cv::Size resultSize;
+    int resultType;
+    
+    std::atomic<uint64_t> completedCount;
+    std::atomic<uint64_t> cancelledCount;
+    
+    // Every task this estimator has submitted, for stopping and for blocking estimates
+    TaskScheduler::TaskGroup tasks;
+    
+    void start();
+    void stop();
+    
+    // Body of a task: estimate depth for the pending request
+    void runPending();
+    void enqueue(const FramePacket& packet, std::shared_ptr<std::promise<DepthResult>> promise, DepthCallback callback);
+    
+    // Complete a request that will never run, with an empty depth map
+    static void finish(Request& request, bool cancelled);
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+
+/**
+ * Fixed-capacity FIFO between two pipeline steps.
+ * push() blocks while the queue is full, so a slow consumer holds its producer back
+ * instead of letting frames pile up; pop() blocks while it is empty. close() wakes
+ * everyone and makes later pushes fail, for shutdown.
+ * Occupancy is sampled on every push, and the time producers spent blocked on a full
+ * queue is accumulated: a queue that is usually full sits in front of the bottleneck,
+ * one that is usually empty sits behind it.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity)
+        : capacity(capacity < 1 ? 1 : capacity)
+        , closed(false)
+        , pushCount(0)
+        , occupancySum(0)
+        , maxOccupancy(0)
+        , fullCount(0)
+        , blockedMs(0.0) {
+    }
+    
+    // Wait for room and append; false if the queue was closed
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (items.size() >= capacity && !closed) {
+            fullCount++;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            notFull.wait(lock, [this]() { return items.size() < capacity || closed; });
+            blockedMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        if (closed) {
+            return false;
+        }
+        
+        items.push_back(std::move(item));
+        pushCount++;
+        occupancySum += items.size();
+        if (items.size() > maxOccupancy) {
+            maxOccupancy = items.size();
+        }
+        lock.unlock();
+        notEmpty.notify_one();
+        return true;
+    }
+    
+    // Wait up to `timeout` for an item; false on timeout or once closed and drained
+    bool pop(T& item, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!notEmpty.wait_for(lock, timeout, [this]() { return !items.empty() || closed; }) || items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return true;
+    }
+    
+    // Take an item if one is waiting
+    bool tryPop(T& item) {
+        return pop(item, std::chrono::milliseconds(0));
+    }
+    
+    // Fail pushes from now on and wake every waiter; items already queued can still be popped
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+    
+    // Reopen after close(), dropping anything left in the queue
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex);
+        items.clear();
+        closed = false;
+    }
+    
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+    }
+    
+    size_t getCapacity() const { return capacity; }
+    
+    // e.g. "1.6/2 avg, 2 max, full on 35% of pushes (120 ms blocked)"
+    std::string occupancySummary() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1)
+            << (pushCount ? static_cast<double>(occupancySum) / pushCount : 0.0) << "/" << capacity << " avg, "
+            << maxOccupancy << " max, full on " << (pushCount ? 100.0 * fullCount / pushCount : 0.0)
+            << "% of pushes (" << blockedMs << " ms blocked)";
+        return out.str();
+    }
+
+private:
+    const size_t capacity;
+    std::deque<T> items;
+    bool closed;
+    mutable std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    
+    // Statistics
+    uint64_t pushCount;
+    uint64_t occupancySum;
+    size_t maxOccupancy;
+    uint64_t fullCount;
+    double blockedMs;
+    
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+};
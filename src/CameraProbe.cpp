@@ -0,0 +1,282 @@
+#include "CameraProbe.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <sys/stat.h>
+
+namespace {
+
+// Results shared between probeConcurrently() and its (possibly abandoned) probe threads
+struct ProbeState {
+    struct Result {
+        bool done = false;
+        bool ok = false;
+        cv::VideoCapture cap;
+        cv::Mat testFrame;
+        CameraProbe::Candidate candidate;
+    };
+    
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<Result> results;
+    bool closed = false;            // The caller has returned; late successes close their device
+    std::vector<bool> threadDone;   // Per probe thread
+};
+
+// A probe thread still running when probeConcurrently() returned
+struct PendingProbe {
+    std::shared_ptr<ProbeState> state;
+    size_t slot;
+    std::thread thread;
+};
+
+// Owns the probe threads a hung device kept running; joined at exit at the latest
+struct PendingProbes {
+    std::mutex mutex;
+    std::vector<PendingProbe> probes;
+    
+    ~PendingProbes() {
+        CameraProbe::joinFinishedProbes(1000);
+    }
+};
+
+PendingProbes pendingProbes;
+
+}
+
+CameraProbe::CameraProbe(const std::string& cachePath)
+    : cachePath(resolveCachePath(cachePath)) {
+}
+
+std::string CameraProbe::resolveCachePath(const std::string& path) {
+    if (path.empty() || path[0] == '/') {
+        return path;
+    }
+    
+    std::string directory;
+    const char* xdgCache = std::getenv("XDG_CACHE_HOME");
+    const char* home = std::getenv("HOME");
+    if (xdgCache && xdgCache[0] == '/') {
+        directory = std::string(xdgCache) + "/fletch_vision";
+    } else if (home && home[0] == '/') {
+        mkdir((std::string(home) + "/.cache").c_str(), 0755);
+        directory = std::string(home) + "/.cache/fletch_vision";
+    } else {
+        return path;
+    }
+    
+    // mkdir fails harmlessly if the directory exists; saveCached() reports a real failure
+    mkdir(directory.c_str(), 0755);
+    return directory + "/" + path;
+}
+
+bool CameraProbe::loadCached(const Settings& settings, Candidate& candidate) const {
+    std::ifstream file(cachePath);
+    if (!file) {
+        return false;
+    }
+    
+    // Format: backend index width height requestedWidth requestedHeight rawYUV
+    int requestedWidth = 0, requestedHeight = 0, rawYUV = 0;
+    if (!(file >> candidate.backend >> candidate.index >> candidate.width >> candidate.height
+               >> requestedWidth >> requestedHeight >> rawYUV)) {
+        return false;
+    }
+    
+    return requestedWidth == settings.preferredWidth && requestedHeight == settings.preferredHeight &&
+           (rawYUV != 0) == settings.rawYUV;
+}
+
+void CameraProbe::saveCached(const Settings& settings, const Candidate& candidate) const {
+    std::ofstream file(cachePath);
+    if (!file) {
+        std::cerr << "Could not write camera probe cache " << cachePath << std::endl;
+        return;
+    }
+    file << candidate.backend << " " << candidate.index << " " << candidate.width << " " << candidate.height << " "
+         << settings.preferredWidth << " " << settings.preferredHeight << " " << (settings.rawYUV ? 1 : 0) << std::endl;
+}
+
+bool CameraProbe::open(const Candidate& candidate, const Settings& settings, cv::VideoCapture& cap, cv::Mat& testFrame) {
+    if (!cap.open(candidate.index, candidate.backend)) {
+        return false;
+    }
+    
+    // A known negotiated resolution skips the driver's search for the closest mode
+    bool cachedMode = candidate.width > 0 && candidate.height > 0;
+    cap.set(cv::CAP_PROP_FRAME_WIDTH, cachedMode ? candidate.width : settings.preferredWidth);
+    cap.set(cv::CAP_PROP_FRAME_HEIGHT, cachedMode ? candidate.height : settings.preferredHeight);
+    if (settings.rawYUV) {
+        cap.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('Y', 'U', 'Y', 'V'));
+        cap.set(cv::CAP_PROP_CONVERT_RGB, 0);
+    }
+    
+    // Test if we can actually read a frame
+    if (!cap.read(testFrame) || testFrame.empty()) {
+        cap.release();
+        return false;
+    }
+    return true;
+}
+
+bool CameraProbe::probeConcurrently(const std::vector<Candidate>& candidates, const Settings& settings, int timeoutMs,
+                                    cv::VideoCapture& cap, cv::Mat& testFrame, Candidate& chosen) {
+    if (candidates.empty()) {
+        return false;
+    }
+    
+    joinFinishedProbes();
+    
+    std::shared_ptr<ProbeState> state = std::make_shared<ProbeState>();
+    state->results.resize(candidates.size());
+    
+    // Group candidates by device index, keeping list order within each group
+    std::map<int, std::vector<size_t>> byIndex;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        byIndex[candidates[i].index].push_back(i);
+    }
+    
+    std::vector<std::thread> threads;
+    state->threadDone.assign(byIndex.size(), false);
+    for (std::map<int, std::vector<size_t>>::const_iterator group = byIndex.begin(); group != byIndex.end(); ++group) {
+        std::vector<size_t> order = group->second;
+        const size_t slot = threads.size();
+        threads.push_back(std::thread([state, slot, order, candidates, settings]() {
+            for (size_t i : order) {
+                cv::VideoCapture probeCap;
+                cv::Mat frame;
+                bool ok = CameraProbe::open(candidates[i], settings, probeCap, frame);
+                
+                std::lock_guard<std::mutex> lock(state->mutex);
+                ProbeState::Result& result = state->results[i];
+                result.done = true;
+                result.ok = ok;
+                result.candidate = candidates[i];
+                if (ok && state->closed) {
+                    // Nobody will take it any more
+                    probeCap.release();
+                    break;
+                }
+                if (ok) {
+                    result.candidate.width = static_cast<int>(probeCap.get(cv::CAP_PROP_FRAME_WIDTH));
+                    result.candidate.height = static_cast<int>(probeCap.get(cv::CAP_PROP_FRAME_HEIGHT));
+                    result.cap = probeCap;
+                    result.testFrame = frame;
+                }
+                state->changed.notify_all();
+                
+                // This device works; later backends for it would only be a fallback
+                if (ok) {
+                    break;
+                }
+            }
+            
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->threadDone[slot] = true;
+            state->changed.notify_all();
+        }));
+    }
+    
+    // Walk the list in priority order, waiting only as long as a better candidate is still pending
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    std::unique_lock<std::mutex> lock(state->mutex);
+    bool found = false;
+    bool timedOut = false;
+    for (size_t i = 0; i < state->results.size() && !found; i++) {
+        ProbeState::Result& result = state->results[i];
+        
+        // A device that already opened on an earlier backend never reports its later ones
+        bool superseded = false;
+        for (size_t j = 0; j < i; j++) {
+            if (candidates[j].index == candidates[i].index && state->results[j].ok) {
+                superseded = true;
+            }
+        }
+        if (superseded) {
+            continue;
+        }
+        
+        while (!result.done) {
+            if (state->changed.wait_until(lock, deadline) == std::cv_status::timeout && !result.done) {
+                break;
+            }
+        }
+        if (!result.done) {
+            // Still hanging: fall through to candidates that have already answered
+            if (!timedOut) {
+                std::cout << "Camera probe timed out after " << timeoutMs << " ms; skipping unresponsive device(s)" << std::endl;
+                timedOut = true;
+            }
+            continue;
+        }
+        
+        if (result.ok) {
+            // VideoCapture copies share the opened device, so the probe thread's handle carries over
+            cap = result.cap;
+            testFrame = result.testFrame;
+            chosen = result.candidate;
+            result.cap = cv::VideoCapture();
+            found = true;
+        }
+    }
+    
+    // Close every other device that opened, and have probes still running close theirs
+    for (ProbeState::Result& result : state->results) {
+        result.cap.release();
+    }
+    state->closed = true;
+    
+    // Join the probes that are done; keep the rest until they finish
+    const std::vector<bool> threadDone = state->threadDone;
+    lock.unlock();
+    std::lock_guard<std::mutex> pendingLock(pendingProbes.mutex);
+    for (size_t slot = 0; slot < threads.size(); slot++) {
+        if (threadDone[slot]) {
+            threads[slot].join();
+            continue;
+        }
+        PendingProbe probe;
+        probe.state = state;
+        probe.slot = slot;
+        probe.thread = std::move(threads[slot]);
+        pendingProbes.probes.push_back(std::move(probe));
+    }
+    return found;
+}
+
+void CameraProbe::joinFinishedProbes(int waitMs) {
+    std::lock_guard<std::mutex> pendingLock(pendingProbes.mutex);
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(waitMs);
+    
+    std::vector<PendingProbe> stillRunning;
+    for (PendingProbe& probe : pendingProbes.probes) {
+        bool finished;
+        {
+            std::unique_lock<std::mutex> lock(probe.state->mutex);
+            finished = probe.state->changed.wait_until(lock, deadline, [&probe]() {
+                return probe.state->threadDone[probe.slot];
+            });
+        }
+        if (finished) {
+            probe.thread.join();
+        } else {
+            stillRunning.push_back(std::move(probe));
+        }
+    }
+    pendingProbes.probes.swap(stillRunning);
+    
+    // Only a driver call that never returns gets here, at exit
+    if (waitMs > 0 && !pendingProbes.probes.empty()) {
+        std::cerr << "⚠️  " << pendingProbes.probes.size() << " camera probe thread(s) still hung in the driver; detaching" << std::endl;
+        for (PendingProbe& probe : pendingProbes.probes) {
+            probe.thread.detach();
+        }
+        pendingProbes.probes.clear();
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * Finds a working camera configuration quickly.
+ * The configuration that worked last time is remembered in a small cache file and
+ * tried first; if it fails, the remaining candidates are opened concurrently (one
+ * thread per device index) and the highest-priority one that delivers a frame
+ * within the timeout wins.
+ */
+class CameraProbe {
+public:
+    // One backend/index pair to try, plus the resolution it negotiated
+    struct Candidate {
+        int backend;
+        int index;
+        int width;   // Negotiated resolution (0 if not known yet)
+        int height;
+        
+        Candidate() : backend(0), index(0), width(0), height(0) {}
+        Candidate(int backend, int index) : backend(backend), index(index), width(0), height(0) {}
+    };
+    
+    // How to configure each candidate before the test read
+    struct Settings {
+        int preferredWidth;
+        int preferredHeight;
+        bool rawYUV;
+    };
+    
+    /**
+     * @param cachePath Cache file. A relative path is resolved against the user's cache
+     *                  directory ($XDG_CACHE_HOME/fletch_vision or ~/.cache/fletch_vision),
+     *                  not the working directory, so every launch finds the same file.
+     */
+    explicit CameraProbe(const std::string& cachePath);
+    
+    const std::string& getCachePath() const { return cachePath; }
+    
+    /**
+     * Load the last working configuration for these settings.
+     * @return false if there is no cache entry or it was recorded for a different request
+     */
+    bool loadCached(const Settings& settings, Candidate& candidate) const;
+    
+    // Remember a working configuration for next startup
+    void saveCached(const Settings& settings, const Candidate& candidate) const;
+    
+    /**
+     * Open a single candidate on the calling thread.
+     * @param cap Receives the opened capture
+     * @param testFrame Receives the first frame read from it
+     */
+    static bool open(const Candidate& candidate, const Settings& settings, cv::VideoCapture& cap, cv::Mat& testFrame);
+    
+    /**
+     * Open candidates concurrently and take the first one, in list order, that works.
+     * Candidates sharing a device index are tried one after another on the same thread
+     * so a device is never opened twice at once. A candidate still running when the
+     * timeout expires is skipped, so a hung device doesn't hide a working one after it.
+     * Probes still running on return close their device when they finish; their threads
+     * stay owned here and are joined once done (see joinFinishedProbes()).
+     * @param chosen Receives the winning candidate with its negotiated resolution
+     */
+    static bool probeConcurrently(const std::vector<Candidate>& candidates, const Settings& settings, int timeoutMs,
+                                  cv::VideoCapture& cap, cv::Mat& testFrame, Candidate& chosen);
+    
+    /**
+     * Join probe threads left running by earlier calls that have since finished.
+     * @param waitMs How long to wait for the rest; any still running after that are
+     *               hung in the driver and are detached
+     */
+    static void joinFinishedProbes(int waitMs = 0);
+    
+private:
+    std::string cachePath;
+    
+    static std::string resolveCachePath(const std::string& path);
+};
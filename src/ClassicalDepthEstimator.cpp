@@ -0,0 +1,137 @@
+#include "ClassicalDepthEstimator.h"
+#include "DepthOverlay.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Output range, matching typical MiDaS small inverse-depth values
+const double kOutputScale = 500.0;
+
+// Floor of the local gradient energy that focus is divided by
+const double kMinTextureEnergy = 1e-6;
+
+}
+
+ClassicalDepthEstimator::ClassicalDepthEstimator()
+    : initialized(false)
+    , workingWidth(160)
+    , focusWeight(0.35f)
+    , textureWeight(0.15f)
+    , positionWeight(0.5f) {
+}
+
+bool ClassicalDepthEstimator::initialize(const std::string& modelPath) {
+    (void)modelPath;
+    initialized = true;
+    std::cout << "✅ Classical depth estimator ready (no model needed)" << std::endl;
+    return true;
+}
+
+void ClassicalDepthEstimator::setCueWeights(float focus, float texture, float position) {
+    float total = focus + texture + position;
+    if (total <= 0.0f) {
+        return;
+    }
+    focusWeight = focus / total;
+    textureWeight = texture / total;
+    positionWeight = position / total;
+}
+
+cv::Mat ClassicalDepthEstimator::estimateDepth(const cv::Mat& inputImage) {
+    FramePacket packet;
+    packet.image = inputImage;
+    cv::Mat depthMap;
+    estimateDepth(packet, depthMap);
+    return depthMap;
+}
+
+cv::Mat ClassicalDepthEstimator::estimateDepth(FramePacket& packet) {
+    cv::Mat depthMap;
+    estimateDepth(packet, depthMap);
+    return depthMap;
+}
+
+bool ClassicalDepthEstimator::estimateDepth(FramePacket& packet, cv::Mat& depthMap) {
+    if (!initialized || packet.image.empty()) {
+        return false;
+    }
+    
+    // Grayscale (luma directly for raw YUV) at working resolution, as float 0-1. Start from
+    // the smallest pyramid level that is still at least the working width.
+    const cv::Size frameSize = packet.imageSize();
+    const cv::Size workingSize(workingWidth, std::max(1, cvRound(static_cast<double>(workingWidth) * frameSize.height / frameSize.width)));
+    int level = 0;
+    while (level < FrameContext::kMaxPyramidLevel && (frameSize.width >> (level + 1)) >= workingWidth) {
+        level++;
+    }
+    const cv::Mat& gray = FrameContext::of(packet, localFrame).grayLevel(packet, level);
+    cv::resize(gray, smallGray, workingSize, 0, 0, cv::INTER_AREA);
+    smallGray.convertTo(small, CV_32F, 1.0 / 255.0);
+    
+    // Texture: gradient energy
+    cv::Sobel(small, gradientX, CV_32F, 1, 0, 3);
+    cv::Sobel(small, gradientY, CV_32F, 0, 1, 3);
+    cv::magnitude(gradientX, gradientY, gradient);
+    
+    // Focus: second-derivative energy relative to gradient energy, so low-contrast but
+    // sharp regions still count as in focus and high-contrast blurred ones don't
+    // (float division follows IEEE, so a flat window would give 0/0 = NaN and spread through
+    // every later filter; the gradient energy is floored just above zero, which makes flat
+    // regions zero focus and leaves the texture cue unchanged once normalized)
+    cv::Laplacian(small, laplacian, CV_32F, 3);
+    cv::absdiff(laplacian, cv::Scalar::all(0), laplacian);
+    cv::boxFilter(laplacian, focus, -1, cv::Size(9, 9));
+    cv::boxFilter(gradient, texture, -1, cv::Size(9, 9));
+    cv::max(texture, cv::Scalar::all(kMinTextureEnergy), texture);
+    cv::divide(focus, texture, focus);
+    localEnergy(focus, focus, 15);
+    localEnergy(texture, texture, 15);
+    
+    // Position: 0 at the top of the frame, 1 at the bottom
+    if (positionPrior.size() != workingSize) {
+        positionPrior.create(workingSize, CV_32F);
+        for (int y = 0; y < workingSize.height; y++) {
+            positionPrior.row(y).setTo(cv::Scalar(static_cast<double>(y) / std::max(1, workingSize.height - 1)));
+        }
+    }
+    
+    // Weighted sum, smoothed so the result reads as surfaces rather than edges
+    cv::addWeighted(focus, focusWeight, texture, textureWeight, 0.0, depthMap);
+    cv::scaleAdd(positionPrior, positionWeight, depthMap, depthMap);
+    cv::GaussianBlur(depthMap, depthMap, cv::Size(0, 0), workingWidth / 40.0);
+    
+    // Scale to about the range MiDaS small produces, so consumers tuned to it (the cube mesh) work unchanged
+    depthMap.convertTo(depthMap, CV_32F, kOutputScale);
+    
+    packet.markStage(FramePacket::STAGE_DEPTH);
+    return true;
+}
+
+void ClassicalDepthEstimator::localEnergy(const cv::Mat& response, cv::Mat& energy, int window) {
+    cv::boxFilter(response, energy, -1, cv::Size(window, window));
+    cv::normalize(energy, energy, 0.0, 1.0, cv::NORM_MINMAX);
+}
+
+cv::Mat ClassicalDepthEstimator::createDepthHeatMap(const cv::Mat& depthMap) {
+    cv::Mat heatMap;
+    if (!DepthOverlay::colorize(depthMap, heatMap)) {
+        return cv::Mat();
+    }
+    return heatMap;
+}
+
+cv::Mat ClassicalDepthEstimator::overlayDepthHeatMap(const cv::Mat& originalImage, const cv::Mat& depthMap, float alpha) {
+    cv::Mat result;
+    if (originalImage.empty() || depthMap.empty() || !overlay.render(originalImage, depthMap, alpha, result)) {
+        return originalImage;
+    }
+    return result;
+}
+
+void ClassicalDepthEstimator::blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) {
+    // Frames the overlay can't draw on are left as they are, as overlayDepthHeatMap() does
+    if (!frame.empty() && !depthMap.empty()) {
+        overlay.render(frame, depthMap, alpha, frame);
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include "IDepthEstimator.h"
+#include "DepthOverlay.h"
+#include "FrameContext.h"
+
+/**
+ * Rough relative depth from classical image cues, for machines that can't run the network.
+ * Works on a small grayscale copy of the frame and combines three cues:
+ *   - focus: high-frequency energy relative to overall gradient energy. Webcams focus on the
+ *     subject, so sharp regions are usually the near ones and defocused ones the background.
+ *   - texture: gradient energy; near surfaces show more resolvable detail.
+ *   - position: lower in the frame is closer (the ground plane and the usual framing).
+ * Each cue is normalized, the weighted sum is smoothed, and the result follows the MiDaS
+ * convention and rough value range, with larger values being nearer. Everything is whole-image OpenCV operations on
+ * a 160-pixel-wide image, so a frame costs well under a millisecond.
+ * No model file is needed.
+ */
+class ClassicalDepthEstimator : public IDepthEstimator {
+public:
+    ClassicalDepthEstimator();
+    
+    // Nothing to load; the model path is ignored
+    bool initialize(const std::string& modelPath = "") override;
+    
+    cv::Mat estimateDepth(const cv::Mat& inputImage) override;
+    cv::Mat estimateDepth(FramePacket& packet) override;
+    bool estimateDepth(FramePacket& packet, cv::Mat& depthMap) override;
+    
+    cv::Mat createDepthHeatMap(const cv::Mat& depthMap) override;
+    cv::Mat overlayDepthHeatMap(const cv::Mat& originalImage, const cv::Mat& depthMap, float alpha = 0.6f) override;
+    void blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) override;
+    
+    bool isInitialized() const override { return initialized; }
+    std::string getDescription() const override { return "Classical depth cues (focus, texture, position)"; }
+    
+    // Relative weights of the cues (normalized internally)
+    void setCueWeights(float focus, float texture, float position);
+    
+private:
+    bool initialized;
+    int workingWidth;
+    float focusWeight;
+    float textureWeight;
+    float positionWeight;
+    
+    // Scratch buffers at working resolution, reused across frames
+    FrameContext localFrame;  // For packets without a context of their own
+    cv::Mat smallGray;
+    cv::Mat small;
+    cv::Mat laplacian;
+    cv::Mat gradientX;
+    cv::Mat gradientY;
+    cv::Mat gradient;
+    cv::Mat focus;
+    cv::Mat texture;
+    cv::Mat positionPrior;  // Rebuilt when the working size changes
+    DepthOverlay overlay;   // Heat map drawing, with its tables and row buffers kept between frames
+    
+    // Local energy of `response`, normalized to 0-1
+    void localEnergy(const cv::Mat& response, cv::Mat& energy, int window);
+};
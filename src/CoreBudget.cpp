@@ -0,0 +1,289 @@
+#include "CoreBudget.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <pthread.h>
+#endif
+
+namespace {
+
+const char* const kRoleNames[CoreBudget::ROLE_COUNT] = {"capture", "inference", "render"};
+
+// A thread that has entered a ThreadScope
+struct ThreadRecord {
+    std::string name;
+    CoreBudget::Role role;
+    bool running;
+    double cpuSeconds;  // Final figure once the thread has finished
+#if defined(__linux__)
+    clockid_t clock;
+#elif defined(__APPLE__)
+    mach_port_t thread;
+#endif
+};
+
+std::mutex recordMutex;
+std::vector<ThreadRecord> records;
+
+// CPU time of a registered thread that is still running, or of the calling thread
+double threadCpuSeconds(const ThreadRecord& record) {
+#if defined(__linux__)
+    timespec time;
+    if (clock_gettime(record.clock, &time) != 0) {
+        return 0.0;
+    }
+    return time.tv_sec + time.tv_nsec * 1e-9;
+#elif defined(__APPLE__)
+    thread_basic_info_data_t info;
+    mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+    if (thread_info(record.thread, THREAD_BASIC_INFO, reinterpret_cast<thread_info_t>(&info), &count) != KERN_SUCCESS) {
+        return 0.0;
+    }
+    return info.user_time.seconds + info.user_time.microseconds * 1e-6 +
+           info.system_time.seconds + info.system_time.microseconds * 1e-6;
+#else
+    (void)record;
+    return 0.0;
+#endif
+}
+
+}
+
+std::vector<int> CoreBudget::cpus[CoreBudget::ROLE_COUNT];
+bool CoreBudget::configured = false;
+
+bool CoreBudget::configure(const std::string& spec) {
+    const int available = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> roleCpus[ROLE_COUNT];
+    
+    if (spec == "auto") {
+        if (available < 3) {
+            std::cout << "⚠️  Only " << available << " CPU(s): not enough to split between capture, inference and rendering" << std::endl;
+            return false;
+        }
+        roleCpus[ROLE_CAPTURE].push_back(0);
+        roleCpus[ROLE_RENDER].push_back(1);
+        for (int cpu = 2; cpu < available; cpu++) {
+            roleCpus[ROLE_INFERENCE].push_back(cpu);
+        }
+    } else {
+        std::stringstream entries(spec);
+        std::string entry;
+        while (std::getline(entries, entry, ',')) {
+            size_t equals = entry.find('=');
+            int role = ROLE_COUNT;
+            for (int r = 0; r < ROLE_COUNT && equals != std::string::npos; r++) {
+                if (entry.compare(0, equals, kRoleNames[r]) == 0) {
+                    role = r;
+                }
+            }
+            if (role == ROLE_COUNT || !parseCpuList(entry.substr(equals + 1), roleCpus[role])) {
+                std::cerr << "❌ Error: Bad core budget entry '" << entry << "' (expected capture|inference|render=CPU or CPU-CPU)" << std::endl;
+                return false;
+            }
+        }
+    }
+    
+    // Roles left out can run anywhere
+    for (int role = 0; role < ROLE_COUNT; role++) {
+        for (int cpu : roleCpus[role]) {
+            if (cpu >= available) {
+                std::cerr << "❌ Error: CPU " << cpu << " in core budget, but only " << available << " CPU(s) available" << std::endl;
+                return false;
+            }
+        }
+        if (roleCpus[role].empty()) {
+            for (int cpu = 0; cpu < available; cpu++) {
+                roleCpus[role].push_back(cpu);
+            }
+        }
+        std::sort(roleCpus[role].begin(), roleCpus[role].end());
+        roleCpus[role].erase(std::unique(roleCpus[role].begin(), roleCpus[role].end()), roleCpus[role].end());
+        cpus[role] = roleCpus[role];
+    }
+    configured = true;
+    
+    cv::setNumThreads(static_cast<int>(cpus[ROLE_INFERENCE].size()));
+#if !defined(__linux__)
+    std::cout << "⚠️  Thread pinning is only supported on Linux; the core budget only sets the DNN thread count" << std::endl;
+#endif
+    std::cout << "✅ Core budget: " << describe() << std::endl;
+    return true;
+}
+
+bool CoreBudget::isConfigured() {
+    return configured;
+}
+
+std::string CoreBudget::describe() {
+    if (!configured) {
+        return "not configured";
+    }
+    std::ostringstream out;
+    for (int role = 0; role < ROLE_COUNT; role++) {
+        out << (role > 0 ? ", " : "") << kRoleNames[role] << " " << formatCpuList(cpus[role]);
+    }
+    out << " (" << cpus[ROLE_INFERENCE].size() << " DNN thread(s))";
+    return out.str();
+}
+
+void CoreBudget::applyInferenceThreads() {
+    if (!configured) {
+        return;
+    }
+    
+    // A smaller count chosen meanwhile (backend auto-selection benchmarks them) still fits
+    // the set; keep it rather than replace a measured winner with something never timed
+    const int setSize = static_cast<int>(cpus[ROLE_INFERENCE].size());
+    int threads = cv::getNumThreads();
+    if (threads <= 0 || threads > setSize) {
+        std::cout << "Core budget resets the DNN thread count from " << threads << " to " << setSize << std::endl;
+        threads = setSize;
+        cv::setNumThreads(threads);
+    }
+    
+#if defined(__linux__)
+    // OpenCV's workers can't be reached directly, so hand every one of them a stripe that
+    // pins it. Each stripe waits until all have started, so no worker takes two stripes
+    // while another takes none. The calling thread runs a stripe too, so restore it after.
+    cpu_set_t previous;
+    const bool restore = pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) == 0;
+    std::atomic<int> started(0);
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    cv::parallel_for_(cv::Range(0, threads), [&](const cv::Range& range) {
+        pinCurrentThread(ROLE_INFERENCE);
+        started += range.end - range.start;
+        while (started < threads && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }, threads);
+    if (restore) {
+        pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+    }
+#endif
+}
+
+size_t CoreBudget::getCpuCount(Role role) {
+    if (!configured) {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+    return cpus[role].size();
+}
+
+bool CoreBudget::pinCurrentThread(Role role) {
+    if (!configured) {
+        return false;
+    }
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus[role]) {
+        CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)role;
+    return false;
+#endif
+}
+
+CoreBudget::ThreadScope::ThreadScope(Role role, const std::string& name) {
+    pinCurrentThread(role);
+    
+    ThreadRecord record;
+    record.name = name;
+    record.role = role;
+    record.running = true;
+    record.cpuSeconds = 0.0;
+#if defined(__linux__)
+    if (pthread_getcpuclockid(pthread_self(), &record.clock) != 0) {
+        record.clock = CLOCK_THREAD_CPUTIME_ID;
+    }
+#elif defined(__APPLE__)
+    record.thread = pthread_mach_thread_np(pthread_self());
+#endif
+    
+    std::lock_guard<std::mutex> lock(recordMutex);
+    slot = records.size();
+    records.push_back(record);
+}
+
+CoreBudget::ThreadScope::~ThreadScope() {
+    std::lock_guard<std::mutex> lock(recordMutex);
+    records[slot].cpuSeconds = threadCpuSeconds(records[slot]);
+    records[slot].running = false;
+}
+
+std::string CoreBudget::cpuTimeSummary() {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << "CPU time:";
+    
+    std::lock_guard<std::mutex> lock(recordMutex);
+    for (const ThreadRecord& record : records) {
+        const double seconds = record.running ? threadCpuSeconds(record) : record.cpuSeconds;
+        out << " " << record.name << " " << seconds << " s (" << kRoleNames[record.role];
+        if (configured) {
+            out << " on " << formatCpuList(cpus[record.role]);
+        }
+        out << "),";
+    }
+    // Everything else, OpenCV's workers included, is the rest of the process total
+    out << " process " << static_cast<double>(std::clock()) / CLOCKS_PER_SEC << " s";
+    return out.str();
+}
+
+bool CoreBudget::parseCpuList(const std::string& list, std::vector<int>& out) {
+    // A single CPU ("3") or an inclusive range ("2-7")
+    char* end = nullptr;
+    long first = std::strtol(list.c_str(), &end, 10);
+    if (end == list.c_str() || first < 0) {
+        return false;
+    }
+    long last = first;
+    if (*end == '-') {
+        const char* rangeEnd = end + 1;
+        last = std::strtol(rangeEnd, &end, 10);
+        if (end == rangeEnd || last < first) {
+            return false;
+        }
+    }
+    if (*end != '\0') {
+        return false;
+    }
+    for (long cpu = first; cpu <= last; cpu++) {
+        out.push_back(static_cast<int>(cpu));
+    }
+    return true;
+}
+
+std::string CoreBudget::formatCpuList(const std::vector<int>& list) {
+    // Sorted CPU numbers back into "0,2-5" form
+    std::ostringstream out;
+    for (size_t i = 0; i < list.size();) {
+        size_t j = i;
+        while (j + 1 < list.size() && list[j + 1] == list[j] + 1) {
+            j++;
+        }
+        out << (i > 0 ? "," : "") << list[i];
+        if (j > i) {
+            out << "-" << list[j];
+        }
+        i = j + 1;
+    }
+    return out.str();
+}
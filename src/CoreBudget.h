@@ -0,0 +1,71 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * Splits the machine's cores between capture, inference and rendering.
+ * Once configured, threads announce their role with a ThreadScope and are pinned to that
+ * role's CPU set (Linux only; elsewhere pinning is skipped), and OpenCV's worker pool is
+ * sized to the inference set and pinned to it. Keeping the roles on their own cores stops
+ * the DNN's workers from migrating onto the capture and render threads' caches.
+ * ThreadScopes also record per-thread CPU time whether or not a budget is configured,
+ * which cpuTimeSummary() reports.
+ */
+class CoreBudget {
+public:
+    enum Role { ROLE_CAPTURE, ROLE_INFERENCE, ROLE_RENDER, ROLE_COUNT };
+    
+    /**
+     * Configure the split. `spec` is "auto" (one core each for capture and rendering, the
+     * rest for inference) or a list of role=CPUs entries such as
+     * "capture=0,render=1,inference=2-7"; a role can be listed more than once.
+     * Roles left out share all CPUs. Call once at startup, before threads start.
+     * @return false if the spec can't be parsed or names CPUs this machine doesn't have
+     */
+    static bool configure(const std::string& spec);
+    static bool isConfigured();
+    
+    // One-line description of the split, e.g. "capture 0, inference 2-7, render 1"
+    static std::string describe();
+    
+    /**
+     * Cap OpenCV's thread pool at the size of the inference set and pin its workers there,
+     * leaving the calling thread's own affinity as it was. A smaller thread count set
+     * meanwhile (e.g. chosen by backend auto-selection) is kept. Call after anything else
+     * that changes cv::setNumThreads.
+     */
+    static void applyInferenceThreads();
+    
+    // CPUs a role's threads may run on; every CPU when no budget is configured
+    static size_t getCpuCount(Role role);
+    
+    // Pin the calling thread to a role's CPUs; false if not configured or not supported
+    static bool pinCurrentThread(Role role);
+    
+    /**
+     * Marks the lifetime of a thread with a role: pins it on construction and records its
+     * CPU time when it ends.
+     */
+    class ThreadScope {
+    public:
+        ThreadScope(Role role, const std::string& name);
+        ~ThreadScope();
+
+    private:
+        size_t slot;
+        
+        ThreadScope(const ThreadScope&) = delete;
+        ThreadScope& operator=(const ThreadScope&) = delete;
+    };
+    
+    // CPU seconds used by each registered thread and by the process as a whole
+    static std::string cpuTimeSummary();
+
+private:
+    static std::vector<int> cpus[ROLE_COUNT];
+    static bool configured;
+    
+    static bool parseCpuList(const std::string& list, std::vector<int>& out);
+    static std::string formatCpuList(const std::vector<int>& list);
+};
@@ -1,7 +1,26 @@
 #include "DepthEstimator.h"
-#include <fstream>
+#include "AllocationCounter.h"
+#include "DnnAutoSelector.h"
+#include "DepthOverlay.h"
+#include "FrameContext.h"
+#include "ResourceUsage.h"
 
-DepthEstimator::DepthEstimator() : modelLoaded(false) {
+DepthEstimator::DepthEstimator()
+    : modelLoaded(false)
+    , inputSize(kModelInputWidth, kModelInputHeight)
+    , lastFrameAllocations(0)
+    , lastFrameAllocatedBytes(0)
+    , lastFrameThreadAllocations(0)
+    , fusedPreprocessor(inputSize, kMeanList, kNormList)
+    , fusedPreprocessEnabled(false)
+    , batchSupport(BATCH_UNKNOWN)
+    , autoSelectBackend(false)
+    , configurationName("FP32 CPU")
+    , warmupRuns(1)
+    , loadTimeMs(0.0)
+    , timeToFirstDepthMs(0.0)
+    , residentBytes(0)
+    , warmupLatencyMs(0.0) {
 }
 
 DepthEstimator::~DepthEstimator() {
@@ -11,34 +30,59 @@ DepthEstimator::~DepthEstimator() {
 bool DepthEstimator::initialize(const std::string& modelPath) {
     try {
         std::cout << "Loading MiDaS depth estimation model from: " << modelPath << std::endl;
+        initializeStart = std::chrono::steady_clock::now();
+        timeToFirstDepthMs = 0.0;
+        const uint64_t residentBefore = ResourceUsage::residentBytes();
         
-        // Check if file exists
-        std::ifstream file(modelPath);
-        if (!file.good()) {
-            std::cerr << "❌ Error: Model file does not exist: " << modelPath << std::endl;
+        // Map the file (or share the mapping another estimator already has) and parse from memory
+        modelBuffer = ModelBuffer::open(modelPath);
+        if (!modelBuffer) {
+            std::cerr << "❌ Error: Model file does not exist or can't be read: " << modelPath << std::endl;
             return false;
         }
-        file.close();
         
-        // Load the ONNX model (based on iwatake2222 implementation)
-        dnnNet = cv::dnn::readNetFromONNX(modelPath);
-        
-        if (dnnNet.empty()) {
-            std::cerr << "❌ Error: Could not load depth estimation model from " << modelPath << std::endl;
-            return false;
+        if (!autoSelectBackend || !selectBackend(modelPath)) {
+            // Load the ONNX model (based on iwatake2222 implementation)
+            dnnNet = cv::dnn::readNetFromONNX(modelBuffer->data(), modelBuffer->size());
+            
+            if (dnnNet.empty()) {
+                std::cerr << "❌ Error: Could not load depth estimation model from " << modelPath << std::endl;
+                return false;
+            }
+            
+            // Set backend and target (same as working example)
+            dnnNet.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+            dnnNet.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+            configurationName = "FP32 CPU";
         }
         
-        // Set backend and target (same as working example)
-        dnnNet.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
-        dnnNet.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+        // The network holds its own weights now; the file pages needn't stay resident
+        modelBuffer->releasePages();
+        loadTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - initializeStart).count();
+        
+        // Output names don't change after loading, so look them up once
+        outputNames = dnnNet.getUnconnectedOutLayersNames();
         
         // Display model information
-        for (const auto& layerName : dnnNet.getUnconnectedOutLayersNames()) {
+        for (const auto& layerName : outputNames) {
             std::cout << "Output layer: " << layerName << std::endl;
         }
         
         modelLoaded = true;
+        
+        // Use the single-pass preprocessing kernel only if it reproduces the reference chain
+        fusedPreprocessEnabled = validateFusedPreprocess();
+        
+        warmUp();
+        
+        const uint64_t residentAfter = ResourceUsage::residentBytes();
+        residentBytes = residentAfter > residentBefore ? residentAfter - residentBefore : 0;
         std::cout << "✅ MiDaS depth estimation model loaded successfully!" << std::endl;
+        std::cout << "⏱️  Model parsed in " << loadTimeMs << " ms";
+        if (timeToFirstDepthMs > 0.0) {
+            std::cout << ", first depth map after " << timeToFirstDepthMs << " ms";
+        }
+        std::cout << ", " << (residentBytes / (1024 * 1024)) << " MB resident" << std::endl;
         
         return true;
     } catch (const cv::Exception& e) {
@@ -48,46 +92,203 @@ bool DepthEstimator::initialize(const std::string& modelPath) {
     }
 }
 
+void DepthEstimator::warmUp() {
+    // Full passes through the normal path, so the preprocessing buffers are sized as well
+    FramePacket packet;
+    packet.image = makeTestFrame();
+    cv::Mat depthMap;
+    double warmTotalMs = 0.0;
+    for (int run = 0; run < warmupRuns; run++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (!runDepth(packet, depthMap)) {
+            std::cout << "⚠️  Depth model warm-up failed" << std::endl;
+            return;
+        }
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        // The first pass allocates layers and buffers, so it says little about a steady frame
+        if (run == 0) {
+            warmupLatencyMs = elapsedMs;
+        } else {
+            warmTotalMs += elapsedMs;
+            warmupLatencyMs = warmTotalMs / run;
+        }
+    }
+}
+
 cv::Mat DepthEstimator::estimateDepth(const cv::Mat& inputImage) {
-    if (!modelLoaded || inputImage.empty()) {
-        return cv::Mat();
+    FramePacket packet;
+    packet.image = inputImage;
+    cv::Mat depthMap;
+    runDepth(packet, depthMap);
+    return depthMap;
+}
+
+cv::Mat DepthEstimator::estimateDepth(FramePacket& packet) {
+    cv::Mat depthMap;
+    estimateDepth(packet, depthMap);
+    return depthMap;
+}
+
+bool DepthEstimator::estimateDepth(FramePacket& packet, cv::Mat& depthMap) {
+    // Process-wide counts catch buffers allocated by parallel_for_ bands and DNN layer
+    // threads, which the calling thread's counts miss
+    uint64_t allocationsBefore = AllocationCounter::processAllocationCount();
+    uint64_t bytesBefore = AllocationCounter::processAllocatedBytes();
+    uint64_t threadAllocationsBefore = AllocationCounter::threadAllocationCount();
+    
+    bool ok = runDepth(packet, depthMap);
+    if (ok) {
+        packet.markStage(FramePacket::STAGE_DEPTH);
+    }
+    
+    lastFrameAllocations = AllocationCounter::processAllocationCount() - allocationsBefore;
+    lastFrameAllocatedBytes = AllocationCounter::processAllocatedBytes() - bytesBefore;
+    lastFrameThreadAllocations = AllocationCounter::threadAllocationCount() - threadAllocationsBefore;
+    return ok;
+}
+
+bool DepthEstimator::runDepth(const FramePacket& packet, cv::Mat& depthMap) {
+    if (!modelLoaded || packet.image.empty()) {
+        depthMap.release();
+        return false;
     }
     
     try {
-        // Preprocess input image (based on iwatake2222 implementation)
-        cv::Mat blobInput;
-        preProcess(inputImage, blobInput);
+        // Build the normalized NCHW model input into the reused blob
+        if (fusedPreprocessEnabled) {
+            fusedPreprocessor.run(fusedSource(packet), packet.format == FramePacket::PIXEL_BGR, blobInput);
+        } else {
+            // Preprocess input image (based on iwatake2222 implementation)
+            preProcess(modelInput(packet), blobInput);
+        }
         
-        // Run inference
-        std::vector<cv::String> outputNames = dnnNet.getUnconnectedOutLayersNames();
-        std::vector<cv::Mat> outputMatList;
+        // Run inference; the output list keeps referring to the network's own output blobs
         inference(blobInput, outputNames, outputMatList);
         
         if (outputMatList.empty()) {
             std::cerr << "❌ Error: No output from depth estimation model" << std::endl;
-            return cv::Mat();
+            depthMap.release();
+            return false;
+        }
+        
+        // Copy the depth map out of the network (into the caller's buffer if it already fits)
+        extractDepth(outputMatList[0], 0, depthMap);
+        if (timeToFirstDepthMs == 0.0) {
+            timeToFirstDepthMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - initializeStart).count();
+        }
+        return true;
+    } catch (const cv::Exception& e) {
+        std::cerr << "❌ Error during depth estimation: " << e.what() << std::endl;
+        depthMap.release();
+        return false;
+    }
+}
+
+std::vector<cv::Mat> DepthEstimator::estimateDepthBatch(std::vector<FramePacket>& packets) {
+    std::vector<cv::Mat> depthMaps(packets.size());
+    if (!modelLoaded || packets.empty()) {
+        return depthMaps;
+    }
+    
+    // A single frame, or a model pinned to batch size 1, goes through the normal path
+    if (packets.size() == 1 || batchSupport == BATCH_UNSUPPORTED) {
+        for (size_t i = 0; i < packets.size(); i++) {
+            depthMaps[i] = estimateDepth(packets[i]);
+        }
+        return depthMaps;
+    }
+    
+    try {
+        // Frames to estimate, skipping empty ones
+        std::vector<size_t> batchIndices;
+        for (size_t i = 0; i < packets.size(); i++) {
+            if (!packets[i].image.empty()) {
+                batchIndices.push_back(i);
+            }
         }
+        if (batchIndices.empty()) {
+            return depthMaps;
+        }
+        
+        // Pack N frames into one N x 3 x H x W blob and run a single forward pass
+        if (fusedPreprocessEnabled) {
+            const int sizes[] = {static_cast<int>(batchIndices.size()), 3, inputSize.height, inputSize.width};
+            batchBlob.create(4, sizes, CV_32F);
+            const size_t entrySize = static_cast<size_t>(3) * inputSize.area();
+            for (size_t b = 0; b < batchIndices.size(); b++) {
+                const FramePacket& packet = packets[batchIndices[b]];
+                fusedPreprocessor.run(fusedSource(packet), packet.format == FramePacket::PIXEL_BGR,
+                                      batchBlob.ptr<float>() + entrySize * b);
+            }
+        } else {
+            batchInputs.resize(batchIndices.size());
+            for (size_t b = 0; b < batchIndices.size(); b++) {
+                normalizeInput(modelInput(packets[batchIndices[b]]), batchInputs[b]);
+            }
+            cv::dnn::blobFromImages(batchInputs, batchBlob);
+        }
+        inference(batchBlob, outputNames, outputMatList);
         
-        // Get depth map from network output
-        cv::Mat matDepth = outputMatList[0];
+        if (outputMatList.empty() || outputMatList[0].size[0] != static_cast<int>(batchIndices.size())) {
+            return estimateDepthSerial(packets, "model output does not have one depth map per input");
+        }
         
-        // If output is 3D (1, H, W), reshape to 2D (H, W)
-        if (matDepth.dims == 3) {
-            std::vector<int> sizes = {matDepth.size[1], matDepth.size[2]};
-            matDepth = matDepth.reshape(0, sizes);
+        // Split the N x H x W output back into per-frame depth maps
+        for (size_t b = 0; b < batchIndices.size(); b++) {
+            extractDepth(outputMatList[0], static_cast<int>(b), depthMaps[batchIndices[b]]);
+            packets[batchIndices[b]].markStage(FramePacket::STAGE_DEPTH);
         }
         
-        return matDepth.clone();
+        if (batchSupport == BATCH_UNKNOWN) {
+            std::cout << "✅ Depth model accepts batched input" << std::endl;
+            batchSupport = BATCH_SUPPORTED;
+        }
+        return depthMaps;
     } catch (const cv::Exception& e) {
-        std::cerr << "❌ Error during depth estimation: " << e.what() << std::endl;
-        return cv::Mat();
+        return estimateDepthSerial(packets, e.what());
+    }
+}
+
+std::vector<cv::Mat> DepthEstimator::estimateDepthSerial(std::vector<FramePacket>& packets, const std::string& reason) {
+    if (batchSupport == BATCH_SUPPORTED) {
+        std::cerr << "❌ Error during batched depth estimation: " << reason << std::endl;
+        return std::vector<cv::Mat>(packets.size());
+    }
+    
+    // Most likely an export with a fixed batch size of 1: remember that and go serial
+    std::cout << "⚠️  Depth model does not accept batched input (" << reason << "), estimating frames one at a time" << std::endl;
+    batchSupport = BATCH_UNSUPPORTED;
+    std::vector<cv::Mat> depthMaps(packets.size());
+    for (size_t i = 0; i < packets.size(); i++) {
+        depthMaps[i] = estimateDepth(packets[i]);
+    }
+    return depthMaps;
+}
+
+void DepthEstimator::extractDepth(const cv::Mat& output, int batchIndex, cv::Mat& depthMap) {
+    // Output is (N, H, W) or (N, 1, H, W); take the H x W plane for one batch entry
+    const int rows = output.size[output.dims - 2];
+    const int cols = output.size[output.dims - 1];
+    const size_t planeSize = static_cast<size_t>(rows) * cols;
+    cv::Mat plane(rows, cols, CV_32F, const_cast<float*>(output.ptr<float>()) + planeSize * batchIndex);
+    plane.copyTo(depthMap);
+}
+
+bool DepthEstimator::setInputSize(cv::Size size) {
+    if (size.width < 32 || size.height < 32 || size.width % 32 != 0 || size.height % 32 != 0) {
+        std::cerr << "❌ Error: Depth model input must be a multiple of 32, got " << size.width << "x" << size.height << std::endl;
+        return false;
     }
+    inputSize = size;
+    fusedPreprocessor.setOutputSize(size);
+    return true;
 }
 
 bool DepthEstimator::normalizeMinMax(const cv::Mat& matDepth, cv::Mat& matDepthNormalized) {
     // Normalize to uint8_t(0-255) (Near = 255, Far = 0)
     // For INFERNO colormap: white/yellow = close, black = far
-    matDepthNormalized = cv::Mat(kModelInputHeight, kModelInputWidth, CV_8UC1);
+    matDepthNormalized.create(matDepth.size(), CV_8UC1);
     double depthMin, depthMax;
     cv::minMaxLoc(matDepth, &depthMin, &depthMax);
     double range = depthMax - depthMin;
@@ -121,7 +322,13 @@ cv::Mat DepthEstimator::overlayDepthHeatMap(const cv::Mat& originalImage, const
         return originalImage;
     }
     
-    // Create heat map
+    // Normalize, colour, upsample and blend in one pass for the usual BGR frame and float depth
+    cv::Mat result;
+    if (overlay.render(originalImage, depthMap, alpha, result)) {
+        return result;
+    }
+    
+    // Anything else goes through the separate steps, starting with the heat map
     cv::Mat heatMap = createDepthHeatMap(depthMap);
     if (heatMap.empty()) {
         return originalImage;
@@ -132,25 +339,115 @@ cv::Mat DepthEstimator::overlayDepthHeatMap(const cv::Mat& originalImage, const
     cv::resize(heatMap, resizedHeatMap, originalImage.size());
     
     // Blend original image with heat map
-    cv::Mat result;
     cv::addWeighted(originalImage, 1.0f - alpha, resizedHeatMap, alpha, 0, result);
     
     return result;
 }
 
-void DepthEstimator::preProcess(const cv::Mat& imageInput, cv::Mat& blobInput) {
-    // Based on iwatake2222 implementation
-    cv::Mat imageNormalize;
-    cv::resize(imageInput, imageNormalize, cv::Size(kModelInputWidth, kModelInputHeight));
-    cv::cvtColor(imageNormalize, imageNormalize, cv::COLOR_BGR2RGB);
-    imageNormalize.convertTo(imageNormalize, CV_32FC3, 1.0 / 255.0);
+void DepthEstimator::blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) {
+    if (frame.empty() || depthMap.empty()) {
+        return;
+    }
+    
+    // The fused kernel writes each row back over the one it read
+    if (!overlay.render(frame, depthMap, alpha, frame)) {
+        frame = overlayDepthHeatMap(frame, depthMap, alpha);
+    }
+}
+
+const cv::Mat& DepthEstimator::fusedSource(const FramePacket& packet) {
+    // BGR frames go straight into the kernel; raw YUV is first converted at model resolution
+    if (packet.format == FramePacket::PIXEL_BGR) {
+        return packet.image;
+    }
+    return modelInput(packet);
+}
+
+const cv::Mat& DepthEstimator::modelInput(const FramePacket& packet) {
+    // Resize and convert to RGB at model resolution in one step, whatever the pixel format.
+    // A frame with a context shares the result with anything else that needs this size.
+    if (packet.context) {
+        return packet.context->resizedRGB(packet, inputSize);
+    }
+    FrameConvert::toResizedRGB(packet, inputSize, modelInputRGB, resizeScratch);
+    return modelInputRGB;
+}
+
+cv::Mat DepthEstimator::makeTestFrame() {
+    // A deterministic camera-sized test frame: smooth gradients plus fine texture
+    cv::Mat testFrame(480, 640, CV_8UC3);
+    for (int y = 0; y < testFrame.rows; y++) {
+        cv::Vec3b* row = testFrame.ptr<cv::Vec3b>(y);
+        for (int x = 0; x < testFrame.cols; x++) {
+            row[x] = cv::Vec3b(static_cast<uchar>((x * 255) / testFrame.cols),
+                               static_cast<uchar>((y * 255) / testFrame.rows),
+                               static_cast<uchar>(((x * 7) ^ (y * 13)) & 0xFF));
+        }
+    }
+    return testFrame;
+}
+
+bool DepthEstimator::selectBackend(const std::string& modelPath) {
+    // Benchmark on the preprocessed test frame so every candidate sees the same input
+    FramePacket testPacket;
+    testPacket.image = makeTestFrame();
+    cv::Mat testBlob;
+    FrameConvert::toResizedRGB(testPacket, inputSize, modelInputRGB, resizeScratch);
+    preProcess(modelInputRGB, testBlob);
+    
+    std::vector<DnnAutoSelector::Candidate> candidates = DnnAutoSelector::defaultCandidates(modelPath);
+    std::vector<DnnAutoSelector::Result> results;
+    const double tolerance = 0.02;  // Of the reference depth range; invisible in the heat map
+    int chosen = DnnAutoSelector::select(candidates, testBlob, tolerance, 5, dnnNet, results);
+    DnnAutoSelector::logResults(results, chosen);
+    
+    if (chosen < 0) {
+        std::cerr << "❌ DNN auto-selection failed, using the default configuration" << std::endl;
+        return false;
+    }
+    configurationName = candidates[chosen].name;
+    return true;
+}
+
+bool DepthEstimator::validateFusedPreprocess() {
+    cv::Mat testFrame = makeTestFrame();
+    FramePacket testPacket;
+    testPacket.image = testFrame;
+    
+    // Reference: resize, swap channels, normalize, transpose
+    cv::Mat referenceBlob;
+    FrameConvert::toResizedRGB(testPacket, inputSize, modelInputRGB, resizeScratch);
+    preProcess(modelInputRGB, referenceBlob);
+    
+    cv::Mat fusedBlob;
+    fusedPreprocessor.run(testFrame, true, fusedBlob);
+    
+    // The reference rounds the resized image to 8 bits, worth up to ~0.01 after normalization
+    const double tolerance = 0.03;
+    double maxError = cv::norm(referenceBlob.reshape(1, 1), fusedBlob.reshape(1, 1), cv::NORM_INF);
+    if (maxError > tolerance) {
+        std::cout << "⚠️  Fused preprocessing differs from reference by " << maxError << ", using reference path" << std::endl;
+        return false;
+    }
+    
+    std::cout << "✅ Fused preprocessing enabled (max difference from reference " << maxError << ")" << std::endl;
+    return true;
+}
+
+void DepthEstimator::normalizeInput(const cv::Mat& imageRGB, cv::Mat& imageNormalize) {
+    // Based on iwatake2222 implementation; input is already RGB at model resolution
+    imageRGB.convertTo(imageNormalize, CV_32FC3, 1.0 / 255.0);
     
     // Apply ImageNet normalization
     cv::subtract(imageNormalize, cv::Scalar(cv::Vec<float, 3>(kMeanList[0], kMeanList[1], kMeanList[2])), imageNormalize);
     cv::divide(imageNormalize, cv::Scalar(cv::Vec<float, 3>(kNormList[0], kNormList[1], kNormList[2])), imageNormalize);
+}
+
+void DepthEstimator::preProcess(const cv::Mat& imageRGB, cv::Mat& blob) {
+    normalizeInput(imageRGB, normalizedInput);
     
-    // Convert NHWC(image) -> NCHW (blob)
-    blobInput = cv::dnn::blobFromImage(imageNormalize);
+    // Convert NHWC(image) -> NCHW (blob), reusing the blob's buffer
+    cv::dnn::blobFromImage(normalizedInput, blob);
 }
 
 void DepthEstimator::inference(const cv::Mat& blobInput, const std::vector<cv::String>& outputNameList, std::vector<cv::Mat>& outputMatList) {
@@ -5,7 +5,13 @@
 #include <iostream>
 #include <string>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include "IDepthEstimator.h"
+#include "DepthOverlay.h"
+#include "FusedPreprocessor.h"
+#include "ModelBuffer.h"
 
 class DepthEstimator : public IDepthEstimator {
 public:
@@ -18,32 +24,134 @@ public:
     // Estimate depth from input image and return depth map
     cv::Mat estimateDepth(const cv::Mat& inputImage) override;
     
+    // Estimate depth for a captured packet; raw YUV frames are converted once, at model resolution
+    cv::Mat estimateDepth(FramePacket& packet) override;
+    
+    // Estimate depth into a caller-owned buffer. Once the buffers are sized by the first frame
+    // this allocates nothing; `depthMap` is overwritten in place when it already has the right size.
+    bool estimateDepth(FramePacket& packet, cv::Mat& depthMap) override;
+    
+    // Mat buffers allocated on any thread during the last estimateDepth() call (needs
+    // AllocationCounter installed; exact only while nothing else allocates Mats meanwhile)
+    uint64_t getLastFrameAllocationCount() const override { return lastFrameAllocations; }
+    uint64_t getLastFrameAllocatedBytes() const { return lastFrameAllocatedBytes; }
+    
+    // Of those, the ones allocated on the calling thread itself
+    uint64_t getLastFrameThreadAllocationCount() const { return lastFrameThreadAllocations; }
+    
+    // Estimate depth for several packets with a single N x 3 x H x W forward pass.
+    // Falls back to one pass per packet if the model was exported with a fixed batch size.
+    std::vector<cv::Mat> estimateDepthBatch(std::vector<FramePacket>& packets) override;
+    
     // Create a colorized heat map from depth data
     cv::Mat createDepthHeatMap(const cv::Mat& depthMap) override;
     
     // Overlay depth heat map on original image
     cv::Mat overlayDepthHeatMap(const cv::Mat& originalImage, const cv::Mat& depthMap, float alpha = 0.6f) override;
     
+    // Overlay depth heat map onto `frame` in place (BGR frame and float depth; others fall back)
+    void blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) override;
+    
     // Check if model is loaded
     bool isInitialized() const override { return modelLoaded; }
     
     // Get description of this depth estimation method
-    std::string getDescription() const override { return "MiDaS v2.1 Neural Network"; }
+    std::string getDescription() const override { return "MiDaS v2.1 Neural Network (" + configurationName + ")"; }
+    
+    // Benchmark the available backend/target/precision/thread configurations during
+    // initialize() and keep the fastest one that matches FP32 output (call before initialize())
+    void setAutoSelectBackend(bool enabled) { autoSelectBackend = enabled; }
+    
+    // Inference passes run on a synthetic frame at the end of initialize(), so the first real
+    // frame doesn't pay for lazy layer allocation (call before initialize(); 0 disables)
+    void setWarmupRuns(int runs) { warmupRuns = runs; }
+    
+    // Startup cost: time to parse the model, time from initialize() to the first depth map
+    // (a warm-up pass or the first real frame; 0 until then) and resident memory added by initialize()
+    double getLoadTimeMs() const { return loadTimeMs; }
+    double getTimeToFirstDepthMs() const { return timeToFirstDepthMs; }
+    uint64_t getResidentBytes() const { return residentBytes; }
+    
+    // What a frame costs on this machine: mean of the warm-up passes after the first, which
+    // pays for lazy allocation (the first pass alone with one run; 0 without warm-up)
+    double getWarmupLatencyMs() const { return warmupLatencyMs; }
+    
+    // Model input resolution. MiDaS is fully convolutional, so any multiple of 32 works with
+    // models exported with dynamic spatial axes; smaller inputs trade detail for speed.
+    // Can be changed between frames. Returns false if the size isn't usable.
+    bool setInputSize(cv::Size size);
+    cv::Size getInputSize() const { return inputSize; }
+    
+    // A deterministic camera-sized test frame for calibration and validation
+    static cv::Mat makeTestFrame();
     
     // Normalize depth map to 0-255 range (based on iwatake2222 implementation)
     bool normalizeMinMax(const cv::Mat& matDepth, cv::Mat& matDepthNormalized);
-    
+
 private:
     cv::dnn::Net dnnNet;
     bool modelLoaded;
     
-    // Model input parameters (MiDaS v2.1 small)
+    // The model file, mapped once per process and shared by every estimator using it.
+    // Each network still parses its own copy of the weights: a cv::dnn::Net can't run
+    // forward passes from several threads, so parsed layers can't be shared between estimators.
+    std::shared_ptr<ModelBuffer> modelBuffer;
+    
+    // Model input parameters (MiDaS v2.1 small by default)
     static constexpr int32_t kModelInputWidth = 256;
     static constexpr int32_t kModelInputHeight = 256;
+    cv::Size inputSize;
     const std::array<float, 3> kMeanList = { 0.485f, 0.456f, 0.406f };
     const std::array<float, 3> kNormList = { 0.229f, 0.224f, 0.225f };
     
+    // Scratch buffers for building the model input
+    cv::Mat modelInputRGB;
+    cv::Mat resizeScratch;
+    std::vector<cv::Mat> batchInputs;  // Normalized per-frame inputs for estimateDepthBatch()
+    cv::Mat normalizedInput;
+    cv::Mat blobInput;
+    cv::Mat batchBlob;
+    
+    // Inference state reused across frames
+    std::vector<cv::String> outputNames;
+    std::vector<cv::Mat> outputMatList;
+    std::atomic<uint64_t> lastFrameAllocations;  // Read from other threads when run asynchronously
+    std::atomic<uint64_t> lastFrameAllocatedBytes;
+    std::atomic<uint64_t> lastFrameThreadAllocations;
+    
+    // Heat map drawing, with its tables and row buffers kept between frames
+    DepthOverlay overlay;
+    
+    // Single-pass resize/swap/normalize/transpose kernel, used once validated against preProcess()
+    FusedPreprocessor fusedPreprocessor;
+    bool fusedPreprocessEnabled;
+    
+    // Whether the model accepts a batch dimension other than 1 (unknown until first tried)
+    enum BatchSupport { BATCH_UNKNOWN, BATCH_SUPPORTED, BATCH_UNSUPPORTED };
+    BatchSupport batchSupport;
+    
+    // DNN configuration in use
+    bool autoSelectBackend;
+    std::string configurationName;
+    
+    // Startup
+    int warmupRuns;
+    std::chrono::steady_clock::time_point initializeStart;
+    double loadTimeMs;
+    double timeToFirstDepthMs;
+    uint64_t residentBytes;
+    double warmupLatencyMs;
+    
     // Helper functions
-    void preProcess(const cv::Mat& imageInput, cv::Mat& blobInput);
+    bool runDepth(const FramePacket& packet, cv::Mat& depthMap);
+    void extractDepth(const cv::Mat& output, int batchIndex, cv::Mat& depthMap);
+    std::vector<cv::Mat> estimateDepthSerial(std::vector<FramePacket>& packets, const std::string& reason);
+    const cv::Mat& fusedSource(const FramePacket& packet);
+    const cv::Mat& modelInput(const FramePacket& packet);
+    bool selectBackend(const std::string& modelPath);
+    void warmUp();
+    bool validateFusedPreprocess();
+    void normalizeInput(const cv::Mat& imageRGB, cv::Mat& imageNormalize);
+    void preProcess(const cv::Mat& imageRGB, cv::Mat& blob);
     void inference(const cv::Mat& blobInput, const std::vector<cv::String>& outputNameList, std::vector<cv::Mat>& outputMatList);
 };
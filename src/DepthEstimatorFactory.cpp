@@ -1,29 +1,58 @@
 #include "DepthEstimatorFactory.h"
 #include "DepthEstimator.h"
+#include "ClassicalDepthEstimator.h"
+#include <fstream>
 #include <iostream>
 #include <vector>
 
-std::unique_ptr<IDepthEstimator> DepthEstimatorFactory::create(const std::string& modelPath) {
-    std::unique_ptr<IDepthEstimator> estimator(new DepthEstimator());
+std::unique_ptr<IDepthEstimator> DepthEstimatorFactory::create(const std::string& modelPath, bool autoSelectBackend) {
+    std::unique_ptr<DepthEstimator> estimator(new DepthEstimator());
+    estimator->setAutoSelectBackend(autoSelectBackend);
     
     if (estimator->initialize(modelPath)) {
         std::cout << "✅ Created depth estimator: " << estimator->getDescription() << std::endl;
-        return estimator;
+        return std::unique_ptr<IDepthEstimator>(estimator.release());
     } else {
         std::cerr << "❌ Failed to initialize depth estimator with model: " << modelPath << std::endl;
         return std::unique_ptr<IDepthEstimator>();
     }
 }
 
-std::unique_ptr<IDepthEstimator> DepthEstimatorFactory::createWithDefaultPaths() {
+namespace {
+
+// Common model locations
+const std::vector<std::string> kSmallModelPaths = {
+    "models/midasv2_small_256x256.onnx",
+    "midasv2_small_256x256.onnx"
+};
+const std::vector<std::string> kLargeModelPaths = {
+    "models/midas_v21_384.onnx",
+    "midas_v21_384.onnx"
+};
+
+// Above this per-frame cost the automatic tier prefers the classical estimator (under 4 FPS)
+const double kMaxNeuralLatencyMs = 250.0;
+
+// Warm-up passes when the automatic tier measures the model: a cold one, then timed ones
+const int kTierWarmupRuns = 3;
+
+std::string findModel(const std::vector<std::string>& paths) {
+    for (const std::string& path : paths) {
+        if (std::ifstream(path).good()) {
+            return path;
+        }
+    }
+    return "";
+}
+
+}
+
+std::unique_ptr<IDepthEstimator> DepthEstimatorFactory::createWithDefaultPaths(bool autoSelectBackend) {
     // Try common model paths
-    std::vector<std::string> modelPaths = {
-        "models/midasv2_small_256x256.onnx",
-        "midasv2_small_256x256.onnx"
-    };
+    const std::vector<std::string>& modelPaths = kSmallModelPaths;
     
     for (const std::string& path : modelPaths) {
-        auto estimator = create(path);
+        auto estimator = create(path, autoSelectBackend);
         if (estimator) {
             return estimator;
         }
@@ -37,3 +66,80 @@ std::unique_ptr<IDepthEstimator> DepthEstimatorFactory::createWithDefaultPaths()
     
     return std::unique_ptr<IDepthEstimator>();
 }
+
+std::unique_ptr<AdaptiveDepthEstimator> DepthEstimatorFactory::createAdaptive(double budgetMs, bool autoSelectBackend) {
+    std::string smallModel = findModel(kSmallModelPaths);
+    if (smallModel.empty()) {
+        std::cerr << "❌ Could not find midasv2_small_256x256.onnx for adaptive depth estimation" << std::endl;
+        return std::unique_ptr<AdaptiveDepthEstimator>();
+    }
+    
+    // The large model is optional; it's only used when there's headroom for it
+    std::string largeModel = findModel(kLargeModelPaths);
+    if (largeModel.empty()) {
+        std::cout << "Large depth model not found, adapting between small model resolutions only" << std::endl;
+    }
+    
+    std::unique_ptr<AdaptiveDepthEstimator> estimator(
+        new AdaptiveDepthEstimator(AdaptiveDepthEstimator::defaultLevels(smallModel, largeModel), budgetMs));
+    estimator->setAutoSelectBackend(autoSelectBackend);
+    
+    if (estimator->initialize()) {
+        std::cout << "✅ Created depth estimator: " << estimator->getDescription() << std::endl;
+        return estimator;
+    }
+    std::cerr << "❌ Failed to initialize adaptive depth estimator" << std::endl;
+    return std::unique_ptr<AdaptiveDepthEstimator>();
+}
+
+std::unique_ptr<IDepthEstimator> DepthEstimatorFactory::createForTier(Tier tier, bool autoSelectBackend) {
+    if (tier == TIER_LOW_POWER) {
+        return createClassical();
+    }
+    if (tier == TIER_NEURAL) {
+        return createWithDefaultPaths(autoSelectBackend);
+    }
+    
+    // Automatic: MiDaS if the model is here and this machine can run it at a usable rate
+    std::string modelPath = findModel(kSmallModelPaths);
+    if (modelPath.empty()) {
+        std::cout << "⚠️  Depth model not found, using classical depth cues instead" << std::endl;
+        return createClassical();
+    }
+    
+    std::unique_ptr<DepthEstimator> estimator(new DepthEstimator());
+    estimator->setAutoSelectBackend(autoSelectBackend);
+    estimator->setWarmupRuns(kTierWarmupRuns);
+    if (!estimator->initialize(modelPath)) {
+        std::cout << "⚠️  Depth model failed to load, using classical depth cues instead" << std::endl;
+        return createClassical();
+    }
+    if (estimator->getWarmupLatencyMs() > kMaxNeuralLatencyMs) {
+        std::cout << "⚠️  MiDaS takes " << estimator->getWarmupLatencyMs() << " ms per frame on this machine, using classical depth cues instead" << std::endl;
+        return createClassical();
+    }
+    
+    std::cout << "✅ Created depth estimator: " << estimator->getDescription() << std::endl;
+    return std::unique_ptr<IDepthEstimator>(estimator.release());
+}
+
+std::unique_ptr<IDepthEstimator> DepthEstimatorFactory::createClassical() {
+    std::unique_ptr<IDepthEstimator> estimator(new ClassicalDepthEstimator());
+    estimator->initialize();
+    std::cout << "✅ Created depth estimator: " << estimator->getDescription() << std::endl;
+    return estimator;
+}
+
+bool DepthEstimatorFactory::parseTier(const std::string& name, Tier& tier) {
+    if (name == "auto") {
+        tier = TIER_AUTO;
+    } else if (name == "neural") {
+        tier = TIER_NEURAL;
+    } else if (name == "low-power") {
+        tier = TIER_LOW_POWER;
+    } else {
+        std::cerr << "❌ Error: Unknown depth tier '" << name << "' (expected auto, neural or low-power)" << std::endl;
+        return false;
+    }
+    return true;
+}
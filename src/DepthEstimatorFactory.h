@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IDepthEstimator.h"
+#include "AdaptiveDepthEstimator.h"
 #include <memory>
 #include <string>
 
@@ -10,16 +11,50 @@
  */
 class DepthEstimatorFactory {
 public:
+    // Which kind of depth estimator to make
+    enum Tier {
+        TIER_AUTO,       // MiDaS, falling back to classical cues if the model is missing or too slow here
+        TIER_NEURAL,     // MiDaS only
+        TIER_LOW_POWER   // Classical cues only; no model, a fraction of the CPU
+    };
+    
     /**
      * Create a depth estimator with the specified model path.
      * @param modelPath Path to the MiDaS ONNX model file
+     * @param autoSelectBackend Benchmark the available DNN configurations at startup and keep the fastest accurate one
      * @return Unique pointer to the created depth estimator, or nullptr if creation failed
      */
-    static std::unique_ptr<IDepthEstimator> create(const std::string& modelPath);
+    static std::unique_ptr<IDepthEstimator> create(const std::string& modelPath, bool autoSelectBackend = false);
     
     /**
      * Create a depth estimator, trying multiple common model paths.
+     * @param autoSelectBackend Benchmark the available DNN configurations at startup and keep the fastest accurate one
+     * @return Unique pointer to the created depth estimator, or nullptr if creation failed
+     */
+    static std::unique_ptr<IDepthEstimator> createWithDefaultPaths(bool autoSelectBackend = false);
+    
+    /**
+     * Create a depth estimator that switches model and input resolution to stay within a
+     * latency budget, using the small model from the default paths and the large model if found.
+     * @param budgetMs Target latency of one depth inference in milliseconds
+     * @param autoSelectBackend Benchmark the available DNN configurations at startup and keep the fastest accurate one
+     * @return The estimator (so callers can subscribe to switch events), or nullptr if creation failed
+     */
+    static std::unique_ptr<AdaptiveDepthEstimator> createAdaptive(double budgetMs, bool autoSelectBackend = false);
+    
+    /**
+     * Create a depth estimator of the given tier, using the default model paths.
+     * @param autoSelectBackend Benchmark the available DNN configurations at startup (MiDaS only)
      * @return Unique pointer to the created depth estimator, or nullptr if creation failed
      */
-    static std::unique_ptr<IDepthEstimator> createWithDefaultPaths();
+    static std::unique_ptr<IDepthEstimator> createForTier(Tier tier, bool autoSelectBackend = false);
+    
+    /**
+     * Create the model-free classical depth estimator.
+     * @return Unique pointer to the created depth estimator
+     */
+    static std::unique_ptr<IDepthEstimator> createClassical();
+    
+    // Parse "auto", "neural" or "low-power"
+    static bool parseTier(const std::string& name, Tier& tier);
 };
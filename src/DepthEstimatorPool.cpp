@@ -0,0 +1,68 @@
+#include "DepthEstimatorPool.h"
+#include "DepthEstimatorFactory.h"
+#include <iostream>
+
+void DepthEstimatorPool::Lease::reset() {
+    if (pool && estimator) {
+        pool->giveBack(estimator);
+    }
+    pool = nullptr;
+    estimator = nullptr;
+}
+
+bool DepthEstimatorPool::initialize(size_t count, const std::string& modelPath) {
+    std::lock_guard<std::mutex> lock(mutex);
+    estimators.clear();
+    available.clear();
+    
+    for (size_t i = 0; i < count; i++) {
+        std::unique_ptr<IDepthEstimator> estimator = modelPath.empty()
+            ? DepthEstimatorFactory::createWithDefaultPaths()
+            : DepthEstimatorFactory::create(modelPath);
+        if (!estimator) {
+            break;
+        }
+        available.push_back(estimator.get());
+        estimators.push_back(std::move(estimator));
+    }
+    
+    if (estimators.empty()) {
+        std::cerr << "❌ Error: Depth estimator pool is empty" << std::endl;
+        return false;
+    }
+    
+    std::cout << "✅ Depth estimator pool ready with " << estimators.size() << " estimator(s)" << std::endl;
+    return true;
+}
+
+DepthEstimatorPool::Lease DepthEstimatorPool::acquire() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (estimators.empty()) {
+        return Lease();
+    }
+    
+    while (available.empty()) {
+        released.wait(lock);
+    }
+    IDepthEstimator* estimator = available.back();
+    available.pop_back();
+    return Lease(this, estimator);
+}
+
+DepthEstimatorPool::Lease DepthEstimatorPool::tryAcquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (available.empty()) {
+        return Lease();
+    }
+    IDepthEstimator* estimator = available.back();
+    available.pop_back();
+    return Lease(this, estimator);
+}
+
+void DepthEstimatorPool::giveBack(IDepthEstimator* estimator) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        available.push_back(estimator);
+    }
+    released.notify_one();
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "IDepthEstimator.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * A fixed set of depth estimators shared by several worker threads.
+ * An estimator is not safe to use from two threads at once, so workers check one
+ * out with acquire() and it returns to the pool when the Lease goes out of scope.
+ */
+class DepthEstimatorPool {
+public:
+    /**
+     * Exclusive use of one pooled estimator; returns it to the pool on destruction.
+     */
+    class Lease {
+    public:
+        Lease() : pool(nullptr), estimator(nullptr) {}
+        Lease(DepthEstimatorPool* pool, IDepthEstimator* estimator) : pool(pool), estimator(estimator) {}
+        Lease(Lease&& other) : pool(other.pool), estimator(other.estimator) {
+            other.pool = nullptr;
+            other.estimator = nullptr;
+        }
+        ~Lease() { reset(); }
+        
+        IDepthEstimator* get() const { return estimator; }
+        IDepthEstimator* operator->() const { return estimator; }
+        explicit operator bool() const { return estimator != nullptr; }
+        
+        // Return the estimator to the pool early
+        void reset();
+        
+    private:
+        Lease(const Lease&);
+        Lease& operator=(const Lease&);
+        
+        DepthEstimatorPool* pool;
+        IDepthEstimator* estimator;
+    };
+    
+    DepthEstimatorPool() = default;
+    
+    /**
+     * Create `count` estimators for the model at `modelPath`, or the default paths if empty.
+     * @return true if at least one estimator was created
+     */
+    bool initialize(size_t count, const std::string& modelPath = "");
+    
+    // Wait for a free estimator. Returns an empty lease if the pool has no estimators.
+    Lease acquire();
+    
+    // Take a free estimator if there is one, without waiting
+    Lease tryAcquire();
+    
+    size_t size() const { return estimators.size(); }
+    
+private:
+    std::vector<std::unique_ptr<IDepthEstimator>> estimators;
+    std::vector<IDepthEstimator*> available;
+    std::mutex mutex;
+    std::condition_variable released;
+    
+    void giveBack(IDepthEstimator* estimator);
+};
@@ -0,0 +1,153 @@
+#include "DepthOverlay.h"
+#include "FusedPreprocessor.h"
+#include "TaskScheduler.h"
+#include <opencv2/core/hal/intrin.hpp>
+#include <algorithm>
+
+namespace {
+
+// Fewest rows worth a task of their own
+const int kMinBandRows = 32;
+
+}
+
+const cv::Vec3b* DepthOverlay::infernoTable() {
+    // Built once, from OpenCV's own colour map so colours match the reference path
+    static const cv::Mat table = []() {
+        cv::Mat levels(1, 256, CV_8UC1);
+        for (int i = 0; i < 256; i++) {
+            levels.at<uchar>(0, i) = static_cast<uchar>(i);
+        }
+        cv::Mat colours;
+        cv::applyColorMap(levels, colours, cv::COLORMAP_INFERNO);
+        return colours;
+    }();
+    return table.ptr<cv::Vec3b>(0);
+}
+
+bool DepthOverlay::render(const cv::Mat& image, const cv::Mat& depthMap, float alpha, cv::Mat& output) {
+    if (image.type() != CV_8UC3 || depthMap.type() != CV_32FC1 || depthMap.empty() || image.empty()) {
+        return false;
+    }
+    
+    // Normalize to 0-255 over the map's own range (near = bright), as normalizeMinMax() does
+    double depthMin, depthMax;
+    cv::minMaxLoc(depthMap, &depthMin, &depthMax);
+    const double range = depthMax - depthMin;
+    if (range <= 0) {
+        return false;
+    }
+    const float scale = static_cast<float>(255.0 / range);
+    const float offset = static_cast<float>(-depthMin * 255.0 / range);
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    buildTables(image.size(), depthMap.size());
+    
+    // 8-bit fixed-point blend weights
+    const int heatWeight = cvRound(std::min(std::max(alpha, 0.0f), 1.0f) * 256.0f);
+    const int imageWeight = 256 - heatWeight;
+    const cv::Vec3b* table = infernoTable();
+    
+    // The overlay is cosmetic, so its bands yield to inference and the other effects
+    const int width = image.cols;
+    output.create(image.size(), CV_8UC3);
+    TaskScheduler& scheduler = TaskScheduler::shared();
+    const int bandCount = std::max(1, std::min(image.rows / kMinBandRows, static_cast<int>(scheduler.getWorkerCount()) * 2));
+    bandDepthRows.create(bandCount, depthMap.cols, CV_32F);
+    bandColourRows.create(bandCount, width * 3, CV_8U);
+    scheduler.parallelFor(bandCount, TaskScheduler::PRIORITY_LOW, [&](int band) {
+        const cv::Range rows(image.rows * band / bandCount, image.rows * (band + 1) / bandCount);
+        float* depthRow = bandDepthRows.ptr<float>(band);
+        uchar* colourRow = bandColourRows.ptr<uchar>(band);
+        const int* x0 = column0.data();
+        const int* x1 = column1.data();
+        const float* wx = columnWeight.data();
+        
+        for (int y = rows.start; y < rows.end; y++) {
+            // Vertical interpolation and normalization at depth resolution, folded into
+            // level = top * a + bottom * c + offset
+            const float* top = depthMap.ptr<float>(row0[y]);
+            const float* bottom = depthMap.ptr<float>(row1[y]);
+            const float a = (1.0f - rowWeight[y]) * scale;
+            const float c = rowWeight[y] * scale;
+            int x = 0;
+#if CV_SIMD
+            const cv::v_float32 va = cv::vx_setall_f32(a);
+            const cv::v_float32 vc = cv::vx_setall_f32(c);
+            const cv::v_float32 vOffset = cv::vx_setall_f32(offset);
+            for (; x <= depthMap.cols - cv::v_float32::nlanes; x += cv::v_float32::nlanes) {
+                cv::v_store(depthRow + x, cv::v_fma(cv::vx_load(top + x), va, cv::v_fma(cv::vx_load(bottom + x), vc, vOffset)));
+            }
+#endif
+            for (; x < depthMap.cols; x++) {
+                depthRow[x] = top[x] * a + (bottom[x] * c + offset);
+            }
+            
+            // Horizontal interpolation and colour lookup at frame resolution: gathers, so scalar
+            for (x = 0; x < width; x++) {
+                float level = depthRow[x0[x]] + wx[x] * (depthRow[x1[x]] - depthRow[x0[x]]);
+                int index = std::min(std::max(static_cast<int>(level + 0.5f), 0), 255);
+                const uchar* colour = table[index].val;
+                colourRow[3 * x] = colour[0];
+                colourRow[3 * x + 1] = colour[1];
+                colourRow[3 * x + 2] = colour[2];
+            }
+            
+            // Blend the colours into the frame in 16-bit fixed point
+            const uchar* in = image.ptr<uchar>(y);
+            uchar* out = output.ptr<uchar>(y);
+            const int length = width * 3;
+            int i = 0;
+#if CV_SIMD
+            const cv::v_uint16 vImageWeight = cv::vx_setall_u16(static_cast<ushort>(imageWeight));
+            const cv::v_uint16 vHeatWeight = cv::vx_setall_u16(static_cast<ushort>(heatWeight));
+            for (; i <= length - cv::v_uint8::nlanes; i += cv::v_uint8::nlanes) {
+                cv::v_uint16 in0, in1, colour0, colour1;
+                cv::v_expand(cv::vx_load(in + i), in0, in1);
+                cv::v_expand(cv::vx_load(colourRow + i), colour0, colour1);
+                cv::v_store(out + i, cv::v_rshr_pack<8>(in0 * vImageWeight + colour0 * vHeatWeight, in1 * vImageWeight + colour1 * vHeatWeight));
+            }
+#endif
+            for (; i < length; i++) {
+                out[i] = static_cast<uchar>((in[i] * imageWeight + colourRow[i] * heatWeight + 128) >> 8);
+            }
+        }
+    });
+    return true;
+}
+
+void DepthOverlay::buildTables(cv::Size imageSize, cv::Size depthSize) {
+    if (imageSize == tableImageSize && depthSize == tableDepthSize) {
+        return;
+    }
+    FusedPreprocessor::buildAxis(depthSize.width, imageSize.width, column0, column1, columnWeight);
+    FusedPreprocessor::buildAxis(depthSize.height, imageSize.height, row0, row1, rowWeight);
+    tableImageSize = imageSize;
+    tableDepthSize = depthSize;
+}
+
+bool DepthOverlay::colorize(const cv::Mat& depthMap, cv::Mat& heatMap) {
+    if (depthMap.type() != CV_32FC1 || depthMap.empty()) {
+        return false;
+    }
+    
+    double depthMin, depthMax;
+    cv::minMaxLoc(depthMap, &depthMin, &depthMax);
+    const double range = depthMax - depthMin;
+    if (range <= 0) {
+        return false;
+    }
+    const float scale = static_cast<float>(255.0 / range);
+    const float offset = static_cast<float>(-depthMin * 255.0 / range);
+    const cv::Vec3b* table = infernoTable();
+    
+    heatMap.create(depthMap.size(), CV_8UC3);
+    for (int y = 0; y < depthMap.rows; y++) {
+        const float* in = depthMap.ptr<float>(y);
+        cv::Vec3b* out = heatMap.ptr<cv::Vec3b>(y);
+        for (int x = 0; x < depthMap.cols; x++) {
+            out[x] = table[std::min(std::max(static_cast<int>(in[x] * scale + offset + 0.5f), 0), 255)];
+        }
+    }
+    return true;
+}
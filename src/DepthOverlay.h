@@ -0,0 +1,51 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <mutex>
+#include <vector>
+
+/**
+ * Draws a depth map over a frame as an inferno heat map in one pass.
+ * The low-resolution depth map is sampled bilinearly at each output pixel, normalized to
+ * its min/max range, looked up in the inferno colour table and blended into the output,
+ * so nothing frame-sized is written except the result. Bands of rows run as low-priority
+ * tasks of the shared TaskScheduler. Each row first blends its two depth rows at depth
+ * resolution, then gathers a colour per pixel through the column tables (scalar, since the
+ * samples aren't contiguous), then blends the colours into the frame; the two blends run
+ * over contiguous rows with OpenCV's universal intrinsics.
+ * Depth is interpolated before colouring rather than after, so colours between depth
+ * samples stay on the colour map instead of mixing neighbouring colours.
+ * The sample tables and row buffers are kept between calls and rebuilt only when the frame
+ * or depth size changes. Calls on one overlay are serialized; use one per owner.
+ */
+class DepthOverlay {
+public:
+    /**
+     * Blend the heat map of `depthMap` (CV_32F, any size) over `image` (CV_8UC3).
+     * `output` may be `image` itself.
+     * @param alpha Weight of the heat map
+     * @return false if the inputs aren't in those formats or the depth map is flat
+     */
+    bool render(const cv::Mat& image, const cv::Mat& depthMap, float alpha, cv::Mat& output);
+    
+    // The heat map of `depthMap` itself, at depth resolution; false if the map is flat or not CV_32F
+    static bool colorize(const cv::Mat& depthMap, cv::Mat& heatMap);
+
+private:
+    std::mutex mutex;
+    
+    // Sample positions of every output column and row in the depth map, for the sizes below
+    cv::Size tableImageSize;
+    cv::Size tableDepthSize;
+    std::vector<int> column0, column1, row0, row1;
+    std::vector<float> columnWeight, rowWeight;
+    
+    // One row per band: depth blended at depth resolution, colours gathered at frame resolution
+    cv::Mat bandDepthRows;
+    cv::Mat bandColourRows;
+    
+    void buildTables(cv::Size imageSize, cv::Size depthSize);
+    
+    // Inferno colour for each normalized depth level, as cv::applyColorMap produces it
+    static const cv::Vec3b* infernoTable();
+};
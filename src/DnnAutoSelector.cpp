@@ -0,0 +1,169 @@
+#include "DnnAutoSelector.h"
+#include "ModelBuffer.h"
+#include <opencv2/core/ocl.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+bool fileExists(const std::string& path) {
+    std::ifstream file(path);
+    return file.good();
+}
+
+DnnAutoSelector::Candidate makeCandidate(const std::string& name, const std::string& modelPath, int target, int threads) {
+    DnnAutoSelector::Candidate candidate;
+    candidate.name = name;
+    candidate.modelPath = modelPath;
+    candidate.backend = cv::dnn::DNN_BACKEND_OPENCV;
+    candidate.target = target;
+    candidate.threads = threads;
+    return candidate;
+}
+
+}
+
+std::vector<DnnAutoSelector::Candidate> DnnAutoSelector::defaultCandidates(const std::string& modelPath) {
+    std::vector<Candidate> candidates;
+    
+    // Reference first: what initialize() has always used
+    candidates.push_back(makeCandidate("FP32 CPU", modelPath, cv::dnn::DNN_TARGET_CPU, 0));
+    
+    // Fewer threads can win when the frame pipeline is busy on other cores. Halve the current
+    // count, which a core budget has already capped at its inference set, so the winner fits it.
+    const int cores = std::max(1, cv::getNumThreads());
+    if (cores >= 4) {
+        candidates.push_back(makeCandidate("FP32 CPU, " + std::to_string(cores / 2) + " threads", modelPath,
+                                           cv::dnn::DNN_TARGET_CPU, cores / 2));
+    }
+    
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 9)
+    // Half-precision CPU kernels (OpenCV 4.9+, used on CPUs with native FP16 arithmetic)
+    candidates.push_back(makeCandidate("FP16 CPU", modelPath, cv::dnn::DNN_TARGET_CPU_FP16, 0));
+#endif
+    
+    if (cv::ocl::haveOpenCL()) {
+        candidates.push_back(makeCandidate("FP32 OpenCL", modelPath, cv::dnn::DNN_TARGET_OPENCL, 0));
+        candidates.push_back(makeCandidate("FP16 OpenCL", modelPath, cv::dnn::DNN_TARGET_OPENCL_FP16, 0));
+    }
+    
+    // Quantized variant exported next to the model, e.g. midasv2_small_256x256_int8.onnx
+    std::string int8Path = modelPath;
+    size_t extension = int8Path.rfind(".onnx");
+    if (extension != std::string::npos) {
+        int8Path.insert(extension, "_int8");
+        if (fileExists(int8Path)) {
+            candidates.push_back(makeCandidate("INT8 CPU", int8Path, cv::dnn::DNN_TARGET_CPU, 0));
+        }
+    }
+    
+    return candidates;
+}
+
+int DnnAutoSelector::select(const std::vector<Candidate>& candidates, const cv::Mat& inputBlob, double tolerance,
+                            int iterations, cv::dnn::Net& chosenNet, std::vector<Result>& results) {
+    results.clear();
+    const int defaultThreads = cv::getNumThreads();
+    
+    cv::Mat reference;
+    double referenceRange = 1.0;
+    int chosenIndex = -1;
+    
+    for (size_t i = 0; i < candidates.size(); i++) {
+        const Candidate& candidate = candidates[i];
+        Result result;
+        result.candidate = candidate;
+        
+        cv::setNumThreads(candidate.threads > 0 ? candidate.threads : defaultThreads);
+        try {
+            // Candidates on the same file share one mapping of it
+            std::shared_ptr<ModelBuffer> model = ModelBuffer::open(candidate.modelPath);
+            cv::dnn::Net net;
+            if (model) {
+                net = cv::dnn::readNetFromONNX(model->data(), model->size());
+            }
+            if (net.empty()) {
+                result.note = "could not load model";
+                results.push_back(result);
+                continue;
+            }
+            net.setPreferableBackend(candidate.backend);
+            net.setPreferableTarget(candidate.target);
+            
+            // The first run compiles kernels and allocates; it isn't timed
+            net.setInput(inputBlob);
+            cv::Mat output = net.forward().clone();
+            result.loaded = true;
+            
+            cv::TickMeter timer;
+            for (int run = 0; run < iterations; run++) {
+                net.setInput(inputBlob);
+                timer.start();
+                net.forward();
+                timer.stop();
+            }
+            result.meanMs = timer.getTimeMilli() / std::max(1, iterations);
+            
+            if (reference.empty()) {
+                // First candidate defines the reference output
+                reference = output;
+                double minValue, maxValue;
+                cv::minMaxLoc(reference, &minValue, &maxValue);
+                referenceRange = std::max(maxValue - minValue, 1e-6);
+                result.passed = true;
+                result.note = "reference";
+            } else if (output.total() != reference.total()) {
+                result.note = "output shape differs from reference";
+            } else {
+                result.maxError = cv::norm(output.reshape(1, 1), reference.reshape(1, 1), cv::NORM_INF) / referenceRange;
+                result.passed = result.maxError <= tolerance;
+                if (!result.passed) {
+                    result.note = "output differs from reference beyond tolerance";
+                }
+            }
+            
+            if (result.passed && (chosenIndex < 0 || result.meanMs < results[chosenIndex].meanMs)) {
+                chosenIndex = static_cast<int>(i);
+                chosenNet = net;
+            }
+        } catch (const cv::Exception& e) {
+            // Target not supported by this build or device
+            result.note = std::string("failed: ") + e.what();
+        }
+        results.push_back(result);
+        
+        // Without a reference there's nothing to validate the rest against
+        if (reference.empty()) {
+            break;
+        }
+    }
+    
+    int chosenThreads = chosenIndex >= 0 ? candidates[chosenIndex].threads : 0;
+    cv::setNumThreads(chosenThreads > 0 ? chosenThreads : defaultThreads);
+    return chosenIndex;
+}
+
+void DnnAutoSelector::logResults(const std::vector<Result>& results, int chosenIndex) {
+    std::cout << "DNN configuration benchmark:" << std::endl;
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        std::cout << (static_cast<int>(i) == chosenIndex ? "  ➜ " : "    ") << std::left << std::setw(24) << result.candidate.name;
+        if (result.loaded) {
+            std::cout << std::fixed << std::setprecision(1) << std::setw(8) << result.meanMs << " ms"
+                      << "  error " << std::setprecision(4) << result.maxError;
+        }
+        if (!result.note.empty()) {
+            std::cout << "  (" << result.note << ")";
+        }
+        std::cout << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6) << std::right;
+    
+    if (chosenIndex >= 0) {
+        std::cout << "✅ Using " << results[chosenIndex].candidate.name
+                  << ": fastest configuration matching the FP32 reference" << std::endl;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <opencv2/dnn.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * Picks the fastest DNN configuration that still gives correct results on this machine.
+ * Each candidate (model file, backend, target, thread count) is loaded, timed on a fixed
+ * input and compared with the plain FP32 CPU output; the fastest one within tolerance wins.
+ * OpenCV's thread count is process-wide, so the winning count is applied with
+ * cv::setNumThreads() rather than per network.
+ */
+class DnnAutoSelector {
+public:
+    // One configuration to try
+    struct Candidate {
+        std::string name;
+        std::string modelPath;
+        int backend;
+        int target;
+        int threads;  // 0 = leave OpenCV's default
+    };
+    
+    // How a candidate did
+    struct Result {
+        Candidate candidate;
+        bool loaded = false;
+        bool passed = false;
+        double meanMs = 0.0;
+        double maxError = 0.0;  // Relative to the reference output's range
+        std::string note;
+    };
+    
+    /**
+     * Candidates worth trying for a model: FP32 CPU at a few thread counts, FP16 targets
+     * where this OpenCV build and machine support them, and an INT8-quantized variant if a
+     * file named <model>_int8.onnx sits next to the model. The first entry is the reference.
+     */
+    static std::vector<Candidate> defaultCandidates(const std::string& modelPath);
+    
+    /**
+     * Benchmark every candidate on `inputBlob` and pick the fastest one that matches the
+     * reference (the first candidate) within `tolerance`.
+     * @param chosenNet Receives the winning network, ready to use
+     * @param results Receives one entry per candidate, for logging
+     * @return Index of the chosen candidate, or -1 if even the reference failed to run
+     */
+    static int select(const std::vector<Candidate>& candidates, const cv::Mat& inputBlob, double tolerance,
+                      int iterations, cv::dnn::Net& chosenNet, std::vector<Result>& results);
+    
+    // One line per candidate explaining the choice
+    static void logResults(const std::vector<Result>& results, int chosenIndex);
+};
@@ -0,0 +1,97 @@
+#include "EdgeDetector.h"
+#include "TaskScheduler.h"
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+// Rows of context above and below each tile. Canny's gradients and non-maximum
+// suppression need two; the rest lets hysteresis follow edge chains across the border.
+const int kHaloRows = 16;
+
+// Smallest tile worth handing to a thread, in output rows
+const int kMinTileRows = 32;
+
+}
+
+EdgeDetector::EdgeDetector()
+    : pyramidLevel(0)
+    , lowThreshold(50.0)
+    , highThreshold(150.0)
+    , frameCount(0)
+    , totalMs(0.0) {
+}
+
+void EdgeDetector::render(const FramePacket& packet, FrameContext& frame, cv::Mat& output) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const cv::Mat& gray = frame.grayLevel(packet, pyramidLevel);
+    output.create(packet.imageSize(), CV_8UC3);
+    if (gray.empty() || output.empty()) {
+        return;
+    }
+    
+    // Which edge column each output column shows when edges are found at reduced resolution
+    if (gray.cols != output.cols) {
+        columnMap.resize(output.cols);
+        for (int x = 0; x < output.cols; x++) {
+            columnMap[x] = x * gray.cols / output.cols;
+        }
+    }
+    
+    // A couple of tiles per worker, so one slow tile doesn't hold up the frame
+    TaskScheduler& scheduler = TaskScheduler::shared();
+    const int tileCount = std::max(1, std::min(output.rows / kMinTileRows, static_cast<int>(scheduler.getWorkerCount()) * 2));
+    tileEdges.resize(tileCount);
+    scheduler.parallelFor(tileCount, TaskScheduler::PRIORITY_NORMAL, [&](int tile) {
+        renderTile(gray, output.rows * tile / tileCount, output.rows * (tile + 1) / tileCount,
+                   tileEdges[tile], output);
+    });
+    
+    frameCount++;
+    totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void EdgeDetector::renderTile(const cv::Mat& gray, int first, int last, cv::Mat& edges, cv::Mat& output) const {
+    // Edge rows behind these output rows, then the halo around them
+    const int edgeFirst = first * gray.rows / output.rows;
+    const int edgeLast = (last - 1) * gray.rows / output.rows + 1;
+    const int haloFirst = std::max(0, edgeFirst - kHaloRows);
+    const int haloLast = std::min(gray.rows, edgeLast + kHaloRows);
+    cv::Canny(gray.rowRange(haloFirst, haloLast), edges, lowThreshold, highThreshold);
+    
+    if (gray.size() == output.size()) {
+        // Full resolution: OpenCV's vectorized gray-to-BGR, straight into the output rows
+        cv::Mat target = output.rowRange(first, last);
+        cv::cvtColor(edges.rowRange(edgeFirst - haloFirst, edgeLast - haloFirst), target, cv::COLOR_GRAY2BGR);
+        return;
+    }
+    
+    // Reduced resolution: nearest-neighbour upscale while writing; output rows showing the
+    // same edge row are copies of the one before
+    const int* columns = columnMap.data();
+    const size_t rowBytes = static_cast<size_t>(output.cols) * 3;
+    int previousEdgeRow = -1;
+    for (int y = first; y < last; y++) {
+        const int edgeRow = y * gray.rows / output.rows;
+        uchar* out = output.ptr<uchar>(y);
+        if (edgeRow == previousEdgeRow) {
+            std::memcpy(out, output.ptr<uchar>(y - 1), rowBytes);
+            continue;
+        }
+        const uchar* in = edges.ptr<uchar>(edgeRow - haloFirst);
+        for (int x = 0; x < output.cols; x++) {
+            const uchar value = in[columns[x]];
+            out[3 * x] = value;
+            out[3 * x + 1] = value;
+            out[3 * x + 2] = value;
+        }
+        previousEdgeRow = edgeRow;
+    }
+}
+
+std::string EdgeDetector::summary() const {
+    std::ostringstream out;
+    out << "Edges: " << frameCount << " frame(s) at " << getMeanMs() << " ms, pyramid level " << pyramidLevel;
+    return out.str();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "FramePacket.h"
+#include "FrameContext.h"
+
+/**
+ * The frame is cut into horizontal tiles that run as tasks of the shared TaskScheduler. Each tile
+ * runs Canny on its rows plus a halo of neighbouring rows, so the gradients and
+ * non-maximum suppression at tile borders match a single whole-frame pass, and
+ * hysteresis only differs for edge chains that leave the halo. Each tile then writes its
+ * edge pixels straight into its rows of the output, with no intermediate gray-to-BGR
+ * image.
+ * Edges can be found on a level of the frame's gray pyramid instead of full resolution
+ * (each level has a quarter of the pixels of the one above); they are scaled back up to
+ * the output size as they are written.
+ */
+class EdgeDetector {
+public:
+    EdgeDetector();
+    
+    // Gray pyramid level to find edges on (0 = full resolution, 1 = half size)
+    void setPyramidLevel(int level) { pyramidLevel = std::max(0, std::min(level, static_cast<int>(FrameContext::kMaxPyramidLevel))); }
+    int getPyramidLevel() const { return pyramidLevel; }
+    
+    // Canny hysteresis thresholds
+    void setThresholds(double low, double high) { lowThreshold = low; highThreshold = high; }
+    
+    /**
+     * Find the edges of `packet`'s frame and draw them into `output`, which is (re)created
+     * as a CV_8UC3 image of the frame's size.
+     * @param frame The frame's derived images, for the gray pyramid level
+     */
+    void render(const FramePacket& packet, FrameContext& frame, cv::Mat& output);
+    
+    // Timing of render(), over all frames
+    uint64_t getFrameCount() const { return frameCount; }
+    double getMeanMs() const { return frameCount ? totalMs / frameCount : 0.0; }
+    std::string summary() const;
+
+private:
+    int pyramidLevel;
+    double lowThreshold;
+    double highThreshold;
+    
+    // Per-tile Canny output, so tiles never share a buffer
+    std::vector<cv::Mat> tileEdges;
+    
+    // Edge column shown at each output column, at reduced resolution
+    std::vector<int> columnMap;
+    
+    uint64_t frameCount;
+    double totalMs;
+    
+    // Edges for output rows [first, last)
+    void renderTile(const cv::Mat& gray, int first, int last, cv::Mat& edges, cv::Mat& output) const;
+};
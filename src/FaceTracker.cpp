@@ -0,0 +1,138 @@
+#include "FaceTracker.h"
+#include <chrono>
+#include <sstream>
+
+namespace {
+
+// How far around its last box a face is searched for, as a fraction of the box size
+const double kSearchMargin = 0.5;
+
+// Smallest face the detector looks for, in full-resolution pixels
+const int kMinFaceSize = 30;
+
+// Longest gap, in frames and in capture time, that tracks are carried across
+const uint64_t kMaxTrackedGapFrames = 5;
+const int64_t kMaxTrackedGapNs = 250000000;
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+FaceTracker::FaceTracker()
+    : detectionInterval(10)
+    , pyramidLevel(1)
+    , processingScale(0.5)
+    , minMatchScore(0.6)
+    , detectionCount(0)
+    , trackingCount(0)
+    , detectionMs(0.0)
+    , trackingMs(0.0) {
+}
+
+bool FaceTracker::loadCascade(const std::string& path) {
+    return cascade.load(path);
+}
+
+const std::vector<cv::Rect>& FaceTracker::update(const FramePacket& packet, const cv::Mat& gray) {
+    SourceState& state = sources[packet.sourceId];
+    if (cascade.empty() || gray.empty()) {
+        state.faces.clear();
+        return state.faces;
+    }
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    processingScale = static_cast<double>(gray.cols) / packet.imageSize().width;
+    
+    // Faces barely move across a few dropped frames; after a long gap, a restarted source
+    // or a new resolution (or a lost track) look again
+    const int64_t captureTimeNs = packet.captureTimeNs();
+    const bool continuous = packet.sequence > state.lastSequence &&
+                            packet.sequence - state.lastSequence <= kMaxTrackedGapFrames &&
+                            captureTimeNs - state.lastCaptureTimeNs <= kMaxTrackedGapNs &&
+                            packet.imageSize() == state.lastFrameSize;
+    state.lastSequence = packet.sequence;
+    state.lastCaptureTimeNs = captureTimeNs;
+    state.lastFrameSize = packet.imageSize();
+    if (!state.detected || state.trackLost || !continuous || state.framesSinceDetection + 1 >= detectionInterval) {
+        detect(state, gray);
+        detectionMs += millisecondsSince(start);
+        detectionCount++;
+    } else {
+        track(state, gray);
+        trackingMs += millisecondsSince(start);
+        trackingCount++;
+    }
+    
+    publish(state);
+    return state.faces;
+}
+
+void FaceTracker::detect(SourceState& state, const cv::Mat& small) {
+    const int minSize = std::max(1, cvRound(kMinFaceSize * processingScale));
+    std::vector<cv::Rect> boxes;
+    cascade.detectMultiScale(small, boxes, 1.1, 3, 0, cv::Size(minSize, minSize));
+    
+    // Each detection becomes a track, remembering what the face looks like now
+    state.tracks.clear();
+    for (const cv::Rect& box : boxes) {
+        Track track;
+        track.box = box;
+        small(box).copyTo(track.patch);
+        state.tracks.push_back(track);
+    }
+    state.framesSinceDetection = 0;
+    state.detected = true;
+    state.trackLost = false;
+}
+
+void FaceTracker::track(SourceState& state, const cv::Mat& small) {
+    const cv::Rect frameRect(0, 0, small.cols, small.rows);
+    
+    for (size_t i = 0; i < state.tracks.size();) {
+        Track& track = state.tracks[i];
+        
+        // Search a neighbourhood of the last position only
+        const int marginX = cvRound(track.box.width * kSearchMargin);
+        const int marginY = cvRound(track.box.height * kSearchMargin);
+        cv::Rect window(track.box.x - marginX, track.box.y - marginY,
+                        track.box.width + 2 * marginX, track.box.height + 2 * marginY);
+        window &= frameRect;
+        
+        double bestScore = -1.0;
+        cv::Point bestLocation;
+        if (window.width >= track.patch.cols && window.height >= track.patch.rows) {
+            cv::matchTemplate(small(window), track.patch, matchScores, cv::TM_CCOEFF_NORMED);
+            cv::minMaxLoc(matchScores, nullptr, &bestScore, nullptr, &bestLocation);
+        }
+        
+        if (bestScore < minMatchScore) {
+            // Lost (occluded, turned away or gone): drop it and detect on the next frame
+            state.tracks.erase(state.tracks.begin() + i);
+            state.trackLost = true;
+            continue;
+        }
+        track.box.x = window.x + bestLocation.x;
+        track.box.y = window.y + bestLocation.y;
+        i++;
+    }
+    state.framesSinceDetection++;
+}
+
+void FaceTracker::publish(SourceState& state) {
+    // Back to frame coordinates
+    const double inverse = 1.0 / processingScale;
+    state.faces.clear();
+    for (const Track& track : state.tracks) {
+        state.faces.push_back(cv::Rect(cvRound(track.box.x * inverse), cvRound(track.box.y * inverse),
+                                       cvRound(track.box.width * inverse), cvRound(track.box.height * inverse)));
+    }
+}
+
+std::string FaceTracker::summary() const {
+    std::ostringstream out;
+    out << "Faces: " << detectionCount << " detection(s) at " << getMeanDetectionMs() << " ms, "
+        << trackingCount << " tracked frame(s) at " << getMeanTrackingMs() << " ms";
+    return out.str();
+}
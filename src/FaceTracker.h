@@ -0,0 +1,88 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "FramePacket.h"
+
+/**
+ * Face boxes at camera rate without running the cascade on every frame.
+ * The Haar cascade runs on a downscaled level of the frame every N frames, and whenever a
+ * track is lost. New faces are therefore picked up within N frames. In between, each face is followed by template matching: the patch found
+ * by the last detection is searched for in a small neighbourhood around the face's last
+ * position. A match below the confidence threshold drops the track and forces a fresh
+ * detection on the next frame.
+ * Tracks are kept per source ID, so one tracker can serve frames from several streams.
+ * A few dropped frames (processing slower than the camera) stay on the tracking path; a
+ * long gap in sequence or capture time, or a change of frame size, restarts with a detection.
+ * Detection and tracking times are accumulated separately.
+ */
+class FaceTracker {
+public:
+    FaceTracker();
+    
+    bool loadCascade(const std::string& path);
+    bool hasCascade() const { return !cascade.empty(); }
+    
+    // Run full detection at least every `frames` frames (1 = detect every frame)
+    void setDetectionInterval(int frames) { detectionInterval = std::max(1, frames); }
+    
+    // Gray pyramid level to detect and track on (0 = full resolution, 1 = half size)
+    void setPyramidLevel(int level) { pyramidLevel = std::max(0, level); }
+    int getPyramidLevel() const { return pyramidLevel; }
+    
+    /**
+     * Find the faces in `gray`, the grayscale image of `packet` at getPyramidLevel()
+     * (e.g. FrameContext::grayLevel()).
+     * @return Face boxes in full-resolution frame coordinates
+     */
+    const std::vector<cv::Rect>& update(const FramePacket& packet, const cv::Mat& gray);
+    
+    // Timing: full detections and tracking-only frames
+    uint64_t getDetectionCount() const { return detectionCount; }
+    uint64_t getTrackingCount() const { return trackingCount; }
+    double getMeanDetectionMs() const { return detectionCount ? detectionMs / detectionCount : 0.0; }
+    double getMeanTrackingMs() const { return trackingCount ? trackingMs / trackingCount : 0.0; }
+    std::string summary() const;
+    
+private:
+    // A followed face, in processing-scale coordinates
+    struct Track {
+        cv::Rect box;
+        cv::Mat patch;  // Appearance at the last detection
+    };
+    
+    // Per-source tracking state
+    struct SourceState {
+        std::vector<Track> tracks;
+        std::vector<cv::Rect> faces;  // Last result, in frame coordinates
+        uint64_t lastSequence = 0;
+        int64_t lastCaptureTimeNs = 0;
+        cv::Size lastFrameSize;
+        int framesSinceDetection = 0;
+        bool detected = false;   // A detection has run for this source
+        bool trackLost = false;
+    };
+    
+    cv::CascadeClassifier cascade;
+    int detectionInterval;
+    int pyramidLevel;
+    double processingScale;  // Of the current frame's gray image against the full frame
+    double minMatchScore;
+    std::map<int, SourceState> sources;
+    
+    // Scratch buffer
+    cv::Mat matchScores;
+    
+    uint64_t detectionCount;
+    uint64_t trackingCount;
+    double detectionMs;
+    double trackingMs;
+    
+    void detect(SourceState& state, const cv::Mat& small);
+    void track(SourceState& state, const cv::Mat& small);
+    void publish(SourceState& state);
+};
@@ -0,0 +1,161 @@
+#include "FrameContext.h"
+#include "FrameConvert.h"
+#include <sstream>
+
+namespace {
+
+const char* const kProductNames[FrameContext::PRODUCT_COUNT] = {"gray", "bgr", "pyramid", "model input"};
+
+}
+
+std::atomic<uint64_t> FrameContext::computedCount[FrameContext::PRODUCT_COUNT];
+std::atomic<uint64_t> FrameContext::reusedCount[FrameContext::PRODUCT_COUNT];
+
+FrameContext::FrameContext()
+    : shared(false)
+    , grayValid(false)
+    , bgrValid(false)
+    , pyramidLevels(0)
+    , lastFrameStart(nullptr) {
+}
+
+void FrameContext::attach(FramePacket& packet, std::vector<std::shared_ptr<FrameContext>>& pool) {
+    packet.context.reset();
+    
+    // A context only the pool refers to is free: no packet (on any thread) still reads it.
+    // Packets share one handle whose deleter holds the pool's reference, so the count is
+    // 2 while any packet holds the context.
+    std::shared_ptr<FrameContext> context;
+    for (const std::shared_ptr<FrameContext>& pooled : pool) {
+        if (pooled.use_count() == 1) {
+            context = pooled;
+            break;
+        }
+    }
+    if (!context) {
+        // The pool grows to the number of frames in flight at once
+        context = std::shared_ptr<FrameContext>(new FrameContext());
+        pool.push_back(context);
+    }
+    
+    context->reset();
+    context->shared = true;
+    Detach detach;
+    detach.context = context;
+    packet.context = std::shared_ptr<FrameContext>(context.get(), detach);
+}
+
+void FrameContext::Detach::operator()(FrameContext*) {
+    context->reset();
+    context.reset();
+}
+
+FrameContext& FrameContext::of(const FramePacket& packet, FrameContext& local) {
+    if (packet.context) {
+        return *packet.context;
+    }
+    local.reset();
+    local.shared = false;
+    return local;
+}
+
+void FrameContext::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    grayValid = false;
+    bgrValid = false;
+    
+    // Views into the last frame would keep its buffer from going back to the capture pool
+    if (grayImage.datastart == lastFrameStart) {
+        grayImage.release();
+    }
+    if (bgrImage.datastart == lastFrameStart) {
+        bgrImage.release();
+    }
+    lastFrameStart = nullptr;
+    pyramidLevels = 0;
+    for (std::map<std::pair<int, int>, ResizedImage>::value_type& entry : resized) {
+        entry.second.valid = false;
+    }
+}
+
+const cv::Mat& FrameContext::gray(const FramePacket& packet) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return grayLocked(packet);
+}
+
+const cv::Mat& FrameContext::grayLocked(const FramePacket& packet) {
+    count(PRODUCT_GRAY, !grayValid);
+    if (!grayValid) {
+        FrameConvert::toGray(packet, grayImage);
+        lastFrameStart = packet.image.datastart;
+        grayValid = true;
+    }
+    return grayImage;
+}
+
+const cv::Mat& FrameContext::bgr(const FramePacket& packet) {
+    std::lock_guard<std::mutex> lock(mutex);
+    count(PRODUCT_BGR, !bgrValid);
+    if (!bgrValid) {
+        FrameConvert::toBGR(packet, bgrImage);
+        lastFrameStart = packet.image.datastart;
+        bgrValid = true;
+    }
+    return bgrImage;
+}
+
+const cv::Mat& FrameContext::grayLevel(const FramePacket& packet, int level) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const cv::Mat& base = grayLocked(packet);
+    if (level <= 0) {
+        return base;
+    }
+    if (level > kMaxPyramidLevel) {
+        level = kMaxPyramidLevel;
+    }
+    
+    // Each level is built from the one above, so asking for level 2 leaves level 1 behind too
+    if (level <= pyramidLevels) {
+        count(PRODUCT_PYRAMID, false);
+    }
+    while (pyramidLevels < level) {
+        const cv::Mat& above = pyramidLevels == 0 ? base : pyramid[pyramidLevels];
+        cv::Mat& below = pyramid[pyramidLevels + 1];
+        cv::resize(above, below, cv::Size((above.cols + 1) / 2, (above.rows + 1) / 2), 0, 0, cv::INTER_AREA);
+        pyramidLevels++;
+        count(PRODUCT_PYRAMID, true);
+    }
+    return pyramid[level];
+}
+
+const cv::Mat& FrameContext::resizedRGB(const FramePacket& packet, const cv::Size& size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ResizedImage& image = resized[std::make_pair(size.width, size.height)];
+    count(PRODUCT_MODEL_INPUT, !image.valid);
+    if (!image.valid) {
+        FrameConvert::toResizedRGB(packet, size, image.rgb, image.scratch);
+        image.valid = true;
+    }
+    return image.rgb;
+}
+
+void FrameContext::count(Product product, bool computed) {
+    if (!shared) {
+        return;
+    }
+    if (computed) {
+        computedCount[product]++;
+    } else {
+        reusedCount[product]++;
+    }
+}
+
+std::string FrameContext::summary() {
+    std::ostringstream out;
+    out << "Frame cache:";
+    for (int product = 0; product < PRODUCT_COUNT; product++) {
+        out << (product > 0 ? "," : "") << " " << kProductNames[product] << " "
+            << computedCount[product] << " computed / " << reusedCount[product] << " reused";
+    }
+    return out.str();
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "FramePacket.h"
+
+/**
+ * Images derived from one frame, computed on first use and shared by every stage that
+ * needs them: grayscale, a downscale pyramid of the grayscale, BGR and RGB resized to a
+ * model's input size. Without it, edge detection, face detection, motion gating and the
+ * depth model each convert or resize the same frame themselves.
+ * A context is attached to the packet (FramePacket::context), so it travels with copies
+ * of the packet onto other threads; products are computed under a lock and stay valid
+ * for as long as the context is attached. Stages receiving a packet without a context
+ * use one of their own via FrameContext::of(), which behaves the same but isn't shared.
+ * Hits and computations of shared contexts are counted process-wide, see summary().
+ */
+class FrameContext {
+public:
+    enum Product {
+        PRODUCT_GRAY,
+        PRODUCT_BGR,
+        PRODUCT_PYRAMID,      // One count per level below full resolution
+        PRODUCT_MODEL_INPUT,  // RGB at a requested size
+        PRODUCT_COUNT
+    };
+    
+    // Pyramid levels available: 0 (full resolution) to kMaxPyramidLevel (1/8 size)
+    static const int kMaxPyramidLevel = 3;
+    
+    FrameContext();
+    
+    /**
+     * Attach a context for `packet`'s frame, recycling one from `pool` that no packet
+     * still refers to, so the derived images' buffers are reused from frame to frame.
+     * When the last packet holding the context lets go of it, the context drops its views
+     * into the frame's buffer at once, so the buffer goes back to the capture pool even
+     * while the context sits unused in `pool`.
+     */
+    static void attach(FramePacket& packet, std::vector<std::shared_ptr<FrameContext>>& pool);
+    
+    // The packet's context if it has one, otherwise `local` cleared for this frame
+    static FrameContext& of(const FramePacket& packet, FrameContext& local);
+    
+    // Grayscale/luma (a view of the Y plane for NV12)
+    const cv::Mat& gray(const FramePacket& packet);
+    
+    // BGR at full resolution (the packet's own image when it is already BGR)
+    const cv::Mat& bgr(const FramePacket& packet);
+    
+    // Grayscale halved `level` times with area averaging; level 0 is gray()
+    const cv::Mat& grayLevel(const FramePacket& packet, int level);
+    
+    // RGB resized to `size`, as fed to a depth model
+    const cv::Mat& resizedRGB(const FramePacket& packet, const cv::Size& size);
+    
+    // Counts across every shared context since startup
+    static uint64_t getComputedCount(Product product) { return computedCount[product]; }
+    static uint64_t getReusedCount(Product product) { return reusedCount[product]; }
+    static std::string summary();
+
+private:
+    struct ResizedImage {
+        cv::Mat rgb;
+        cv::Mat scratch;
+        bool valid = false;
+    };
+    
+    std::mutex mutex;
+    bool shared;  // Attached to packets, so counted
+    
+    cv::Mat grayImage;
+    cv::Mat bgrImage;
+    cv::Mat pyramid[kMaxPyramidLevel + 1];  // [0] unused; level 0 is grayImage
+    std::map<std::pair<int, int>, ResizedImage> resized;  // Keyed by width, height; nodes stay put
+    bool grayValid;
+    bool bgrValid;
+    int pyramidLevels;  // Levels computed so far, beyond level 0
+    const uchar* lastFrameStart;  // Buffer of the frame the images came from
+    
+    static std::atomic<uint64_t> computedCount[PRODUCT_COUNT];
+    static std::atomic<uint64_t> reusedCount[PRODUCT_COUNT];
+    
+    // Deleter of the packets' handle: resets the pooled context, then lets go of it
+    struct Detach {
+        std::shared_ptr<FrameContext> context;
+        void operator()(FrameContext*);
+    };
+    
+    // Forget the previous frame's images and views of its buffer, keeping our own buffers
+    void reset();
+    
+    const cv::Mat& grayLocked(const FramePacket& packet);
+    void count(Product product, bool computed);
+    
+    FrameContext(const FrameContext&) = delete;
+    FrameContext& operator=(const FrameContext&) = delete;
+};
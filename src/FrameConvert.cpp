@@ -0,0 +1,61 @@
+#include "FrameConvert.h"
+
+void FrameConvert::toGray(const FramePacket& packet, cv::Mat& gray) {
+    switch (packet.format) {
+        case FramePacket::PIXEL_NV12:
+            // The Y plane is already a grayscale image
+            gray = packet.image.rowRange(0, packet.imageSize().height);
+            break;
+        case FramePacket::PIXEL_YUYV:
+            cv::extractChannel(packet.image, gray, 0);
+            break;
+        default:
+            cv::cvtColor(packet.image, gray, cv::COLOR_BGR2GRAY);
+            break;
+    }
+}
+
+void FrameConvert::toBGR(const FramePacket& packet, cv::Mat& bgr) {
+    switch (packet.format) {
+        case FramePacket::PIXEL_NV12:
+            cv::cvtColor(packet.image, bgr, cv::COLOR_YUV2BGR_NV12);
+            break;
+        case FramePacket::PIXEL_YUYV:
+            cv::cvtColor(packet.image, bgr, cv::COLOR_YUV2BGR_YUYV);
+            break;
+        default:
+            bgr = packet.image;
+            break;
+    }
+}
+
+void FrameConvert::toResizedRGB(const FramePacket& packet, const cv::Size& size, cv::Mat& rgb, cv::Mat& scratch) {
+    const cv::Mat& image = packet.image;
+    
+    switch (packet.format) {
+        case FramePacket::PIXEL_NV12: {
+            // Resize the Y plane and the half-resolution UV plane into a small NV12 image
+            const int height = packet.imageSize().height;
+            scratch.create(size.height * 3 / 2, size.width, CV_8UC1);
+            cv::Mat yPlane = scratch.rowRange(0, size.height);
+            cv::Mat uvPlane = scratch.rowRange(size.height, size.height * 3 / 2).reshape(2, size.height / 2);
+            cv::resize(image.rowRange(0, height), yPlane, size);
+            cv::resize(image.rowRange(height, height * 3 / 2).reshape(2, height / 2), uvPlane,
+                       cv::Size(size.width / 2, size.height / 2));
+            cv::cvtColor(scratch, rgb, cv::COLOR_YUV2RGB_NV12);
+            break;
+        }
+        case FramePacket::PIXEL_YUYV: {
+            // Treat each Y0 U Y1 V macro-pixel as one 4-channel pixel so chroma stays paired with luma
+            scratch.create(size.height, size.width / 2, CV_8UC(4));
+            cv::resize(image.reshape(4), scratch, cv::Size(size.width / 2, size.height));
+            cv::cvtColor(scratch.reshape(2), rgb, cv::COLOR_YUV2RGB_YUYV);
+            break;
+        }
+        default:
+            // Resize first so the channel swap runs on the small image
+            cv::resize(image, scratch, size);
+            cv::cvtColor(scratch, rgb, cv::COLOR_BGR2RGB);
+            break;
+    }
+}
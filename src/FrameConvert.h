@@ -0,0 +1,22 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include "FramePacket.h"
+
+/**
+ * Colour conversions from a FramePacket in any supported pixel format.
+ * Each consumer asks for exactly the representation it needs, so raw YUV frames
+ * go through at most one conversion per consumer instead of camera->BGR->X chains.
+ */
+class FrameConvert {
+public:
+    // Grayscale/luma. Zero-copy view for NV12, one channel extract for YUYV.
+    static void toGray(const FramePacket& packet, cv::Mat& gray);
+    
+    // BGR at full resolution. Shallow copy when the packet is already BGR.
+    static void toBGR(const FramePacket& packet, cv::Mat& bgr);
+    
+    // RGB resized to `size`. YUV frames are resized in their native layout first so the
+    // colour conversion only touches the small image. `scratch` is reused between calls.
+    static void toResizedRGB(const FramePacket& packet, const cv::Size& size, cv::Mat& rgb, cv::Mat& scratch);
+};
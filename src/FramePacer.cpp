@@ -0,0 +1,34 @@
+#include "FramePacer.h"
+#include <thread>
+
+FramePacer::FramePacer(double fps, bool realTime) : realTime(realTime), started(false) {
+    setFrameRate(fps);
+}
+
+void FramePacer::setFrameRate(double fps) {
+    // Video containers sometimes report 0 or NaN, so guard against nonsense rates
+    frameRate = (fps > 0.0 && fps < 1000.0) ? fps : 30.0;
+    frameInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frameRate));
+}
+
+void FramePacer::waitForNextFrame() {
+    if (!realTime) {
+        return;
+    }
+    
+    Clock::time_point now = Clock::now();
+    if (!started) {
+        nextFrameTime = now;
+        started = true;
+    }
+    
+    if (nextFrameTime > now) {
+        std::this_thread::sleep_until(nextFrameTime);
+    }
+    nextFrameTime += frameInterval;
+    
+    // If the consumer fell more than a frame behind, don't burst to catch up
+    if (nextFrameTime + frameInterval < now) {
+        nextFrameTime = now + frameInterval;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+
+/**
+ * Paces frame delivery for replayed and synthetic sources.
+ * In real-time mode waitForNextFrame() sleeps until the next frame is due,
+ * otherwise it returns immediately so sources run as fast as possible.
+ */
+class FramePacer {
+public:
+    explicit FramePacer(double fps = 30.0, bool realTime = true);
+    
+    // Set the target frame rate (non-positive values fall back to 30 FPS)
+    void setFrameRate(double fps);
+    double getFrameRate() const { return frameRate; }
+    
+    // Enable or disable real-time pacing
+    void setRealTime(bool enabled) { realTime = enabled; }
+    bool isRealTime() const { return realTime; }
+    
+    // Block until the next frame is due (no-op when not real-time)
+    void waitForNextFrame();
+    
+    // Restart the schedule from the next call to waitForNextFrame()
+    void reset() { started = false; }
+    
+private:
+    typedef std::chrono::steady_clock Clock;
+    
+    double frameRate;
+    Clock::duration frameInterval;
+    Clock::time_point nextFrameTime;
+    bool realTime;
+    bool started;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+class FrameContext;
+
+/**
+ * A captured frame plus the bookkeeping needed to follow it through the pipeline:
+ * a monotonic capture timestamp, the source's sequence number and the source ID.
+ * Stages stamp the packet as they finish so capture-to-display latency can be measured,
+ * and gaps in sequence numbers reveal frames dropped along the way.
+ * A FrameContext can be attached to share derived images (gray, resized) between stages.
+ */
+struct FramePacket {
+    // Pipeline stages that stamp a packet, in order
+    enum Stage {
+        STAGE_CAPTURE,
+        STAGE_PROCESS,
+        STAGE_DEPTH,
+        STAGE_UPLOAD,
+        STAGE_DISPLAY,
+        STAGE_COUNT
+    };
+    
+    // Memory layout of `image`; raw camera layouts skip the backend's BGR conversion
+    enum PixelFormat {
+        PIXEL_BGR,   // CV_8UC3, the OpenCV default
+        PIXEL_YUYV,  // CV_8UC2 packed 4:2:2, Y in channel 0
+        PIXEL_NV12   // CV_8UC1, height * 3/2 rows: Y plane followed by interleaved UV
+    };
+    
+    cv::Mat image;
+    PixelFormat format;
+    uint64_t sequence;
+    int sourceId;
+    int64_t stageTimeNs[STAGE_COUNT];  // Monotonic time each stage finished, 0 if not reached
+    std::shared_ptr<FrameContext> context;  // Derived images of this frame, if attached
+    
+    FramePacket() : format(PIXEL_BGR), sequence(0), sourceId(0) {
+        clearStages();
+    }
+    
+    // Monotonic clock shared by every stage, in nanoseconds
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    // Size of the picture itself (NV12 buffers carry extra chroma rows)
+    cv::Size imageSize() const {
+        if (format == PIXEL_NV12) {
+            return cv::Size(image.cols, image.rows * 2 / 3);
+        }
+        return cv::Size(image.cols, image.rows);
+    }
+    
+    int64_t captureTimeNs() const { return stageTimeNs[STAGE_CAPTURE]; }
+    
+    void markStage(Stage stage) { stageTimeNs[stage] = now(); }
+    bool reachedStage(Stage stage) const { return stageTimeNs[stage] != 0; }
+    
+    // Milliseconds from capture until the given stage finished (negative if not reached)
+    double stageLatencyMs(Stage stage) const {
+        if (!reachedStage(stage) || !reachedStage(STAGE_CAPTURE)) {
+            return -1.0;
+        }
+        return (stageTimeNs[stage] - stageTimeNs[STAGE_CAPTURE]) / 1e6;
+    }
+    
+    void clearStages() {
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            stageTimeNs[i] = 0;
+        }
+    }
+    
+    static const char* stageName(Stage stage) {
+        switch (stage) {
+            case STAGE_CAPTURE: return "capture";
+            case STAGE_PROCESS: return "process";
+            case STAGE_DEPTH: return "depth";
+            case STAGE_UPLOAD: return "upload";
+            case STAGE_DISPLAY: return "display";
+            default: return "unknown";
+        }
+    }
+};
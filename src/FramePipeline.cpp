@@ -0,0 +1,127 @@
+#include "FramePipeline.h"
+#include "CoreBudget.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// How long a step waits on an empty queue before checking whether it should stop
+const std::chrono::milliseconds kPollTimeout(50);
+
+}
+
+FramePipeline::FramePipeline(IWebcamCapture& source, FrameProcessor& processor, IDepthEstimator* depthEstimator, size_t depth)
+    : source(source)
+    , processor(processor)
+    , depthEstimator(depthEstimator)
+    , prepared(depth)
+    , finished(depth)
+    , outputPool(std::max<size_t>(1, depth) + 2)  // Queued, being displayed and being finished
+    , running(false)
+    , processedCount(0) {
+    // Capture frames live from the prepare step until processing is done: the queue plus
+    // one in each step
+    source.reserveFrameBuffers(getDepth() + 2);
+}
+
+FramePipeline::~FramePipeline() {
+    stop();
+}
+
+bool FramePipeline::start() {
+    if (running) {
+        return false;
+    }
+    
+    prepared.reset();
+    finished.reset();
+    running = true;
+    prepareThread = std::thread(&FramePipeline::prepareLoop, this);
+    processThread = std::thread(&FramePipeline::processLoop, this);
+    
+    std::cout << "✅ Frame pipeline running with queue depth " << getDepth() << std::endl;
+    return true;
+}
+
+void FramePipeline::stop() {
+    if (!running) {
+        return;
+    }
+    
+    running = false;
+    prepared.close();
+    finished.close();
+    if (prepareThread.joinable()) {
+        prepareThread.join();
+    }
+    if (processThread.joinable()) {
+        processThread.join();
+    }
+}
+
+void FramePipeline::prepareLoop() {
+    CoreBudget::ThreadScope threadScope(CoreBudget::ROLE_CAPTURE, "prepare");
+    
+    FramePacket packet;
+    while (running) {
+        // The source hands out the newest frame; frames the pipeline is too slow for are
+        // dropped there, not queued here
+        if (!source.waitForFrame(kPollTimeout)) {
+            continue;
+        }
+        if (!source.capturePacket(packet) || packet.image.empty()) {
+            // Not ready after all, or the source failed; don't spin on it
+            std::this_thread::sleep_for(kPollTimeout);
+            continue;
+        }
+        
+        processor.prepare(packet);
+        if (!prepared.push(std::move(packet))) {
+            break;
+        }
+        packet = FramePacket();
+    }
+}
+
+void FramePipeline::processLoop() {
+    CoreBudget::ThreadScope threadScope(CoreBudget::ROLE_INFERENCE, "process");
+    
+    FramePacket packet;
+    while (running) {
+        if (!prepared.pop(packet, kPollTimeout)) {
+            continue;
+        }
+        
+        cv::Mat processed = processor.process(packet, depthEstimator);
+        if (processedCallback) {
+            processedCallback(packet);
+        }
+        
+        // Finish into a pooled image: the processor reuses its own buffer on the next frame
+        Output output;
+        output.image = outputPool.acquire(processed.size(), processed.type());
+        if (finish) {
+            finish(processed, output.image);
+        } else {
+            processed.copyTo(output.image);
+        }
+        output.packet = std::move(packet);
+        output.packet.context.reset();  // Done with; lets the prepare step reuse it
+        output.packet.image.release();  // Display only needs the stage times; back to the capture pool
+        packet = FramePacket();
+        processedCount++;
+        
+        if (!finished.push(std::move(output))) {
+            break;
+        }
+    }
+}
+
+std::string FramePipeline::summary() const {
+    std::ostringstream out;
+    out << "Pipeline queues: prepare->process " << prepared.occupancySummary()
+        << "; process->display " << finished.occupancySummary();
+    return out.str();
+}
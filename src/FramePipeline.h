@@ -0,0 +1,91 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include "BoundedQueue.h"
+#include "FramePacket.h"
+#include "FramePool.h"
+#include "FrameProcessor.h"
+#include "IDepthEstimator.h"
+#include "IWebcamCapture.h"
+
+/**
+ * Overlaps the steps of consecutive frames instead of taking each frame from capture
+ * to screen before starting the next.
+ * A prepare thread captures frames and computes their derived images, a processing
+ * thread runs the effects (depth inference included) and finishes each result into an
+ * image ready for display, and the display thread takes finished frames whenever it
+ * draws. So frame N+1 is being captured and prepared while frame N is processed and
+ * frame N-1 is uploaded and shown, and sustained throughput approaches the rate of the
+ * slowest step rather than the inverse of their summed times.
+ * Steps are joined by bounded queues of the configured depth: deeper queues absorb
+ * jitter and keep every step busy, at the price of frames waiting longer before they
+ * are shown. Each queue reports its occupancy, which shows where the bottleneck is.
+ */
+class FramePipeline {
+public:
+    // A processed frame, ready for display
+    struct Output {
+        FramePacket packet;  // Stage times only; the captured image is already back with the source
+        cv::Mat image;  // From the pipeline's pool; released once the caller drops it
+    };
+    
+    // Turns the composited frame into what the display takes (e.g. flipped for OpenGL)
+    typedef std::function<void(const cv::Mat& processed, cv::Mat& output)> FinishFunction;
+    
+    // Called on the processing thread after each frame is processed
+    typedef std::function<void(const FramePacket& packet)> ProcessedCallback;
+    
+    /**
+     * @param source Frame source (must outlive the pipeline)
+     * @param processor Effects to apply (must outlive the pipeline)
+     * @param depthEstimator Passed to FrameProcessor::process(); may be null
+     * @param depth Capacity of each queue between steps (at least 1). The source is asked
+     *              to keep depth + 2 capture buffers, since that many frames can be in flight.
+     */
+    FramePipeline(IWebcamCapture& source, FrameProcessor& processor, IDepthEstimator* depthEstimator, size_t depth);
+    ~FramePipeline();
+    
+    // Set before start(). Without a finish function the processed frame is copied.
+    void setFinishFunction(FinishFunction function) { finish = function; }
+    void setProcessedCallback(ProcessedCallback callback) { processedCallback = callback; }
+    
+    bool start();
+    
+    // Stop and join the threads; frames still in the queues are dropped
+    void stop();
+    
+    bool isRunning() const { return running; }
+    size_t getDepth() const { return prepared.getCapacity(); }
+    
+    // Take the oldest finished frame without waiting; false if there is none yet
+    bool tryGetOutput(Output& output) { return finished.tryPop(output); }
+    
+    uint64_t getProcessedCount() const { return processedCount; }
+    
+    // Occupancy of each queue
+    std::string summary() const;
+
+private:
+    IWebcamCapture& source;
+    FrameProcessor& processor;
+    IDepthEstimator* depthEstimator;
+    FinishFunction finish;
+    ProcessedCallback processedCallback;
+    
+    BoundedQueue<FramePacket> prepared;   // Prepare -> process
+    BoundedQueue<Output> finished;        // Process -> display
+    FramePool outputPool;                 // Finished images, recycled once displayed
+    
+    std::atomic<bool> running;
+    std::thread prepareThread;
+    std::thread processThread;
+    std::atomic<uint64_t> processedCount;
+    
+    void prepareLoop();
+    void processLoop();
+};
@@ -0,0 +1,70 @@
+#include "FramePool.h"
+
+FramePool::FramePool(size_t capacity) : capacity(capacity), allocations(0), overflows(0) {
+    buffers.reserve(capacity);
+}
+
+bool FramePool::isFree(const cv::Mat& buffer) {
+    // Atomic read of the shared reference count; 1 means only the pool's own header refers to it
+    return buffer.u != nullptr && CV_XADD(&buffer.u->refcount, 0) == 1;
+}
+
+cv::Mat FramePool::acquire(const cv::Size& size, int type) {
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    // Prefer a free buffer that already has the right geometry
+    for (cv::Mat& buffer : buffers) {
+        if (buffer.size() == size && buffer.type() == type && isFree(buffer)) {
+            return buffer;
+        }
+    }
+    
+    // Grow the pool until it reaches capacity
+    if (buffers.size() < capacity) {
+        buffers.push_back(cv::Mat(size, type));
+        allocations++;
+        return buffers.back();
+    }
+    
+    // Reuse a free buffer of the wrong geometry (e.g. after a resolution change)
+    for (cv::Mat& buffer : buffers) {
+        if (isFree(buffer)) {
+            buffer.create(size, type);
+            allocations++;
+            return buffer;
+        }
+    }
+    
+    // Every buffer is held by a consumer; hand out a one-off buffer rather than stall capture
+    overflows++;
+    allocations++;
+    return cv::Mat(size, type);
+}
+
+size_t FramePool::getCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacity;
+}
+
+void FramePool::reserve(size_t minimum) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (minimum > capacity) {
+        capacity = minimum;
+        buffers.reserve(capacity);
+    }
+}
+
+void FramePool::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    buffers.clear();
+}
+
+uint64_t FramePool::getAllocationCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return allocations;
+}
+
+uint64_t FramePool::getOverflowCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return overflows;
+}
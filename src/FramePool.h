@@ -0,0 +1,46 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * Fixed-size pool of frame buffers for the capture path.
+ * acquire() hands out a cv::Mat that shares one of the pooled buffers; OpenCV's own
+ * reference count tracks consumers, and the buffer becomes available again once every
+ * copy of it has been released. After the pool has filled, steady-state capture does
+ * not touch the heap.
+ */
+class FramePool {
+public:
+    explicit FramePool(size_t capacity = 4);
+    
+    // Get a buffer with the given geometry. Contents are undefined.
+    // If every pooled buffer is still in use a temporary, unpooled buffer is returned.
+    cv::Mat acquire(const cv::Size& size, int type);
+    
+    // Drop all pooled buffers (buffers still held by consumers stay valid)
+    void clear();
+    
+    size_t getCapacity() const;
+    
+    // Raise the capacity to at least `minimum` buffers
+    void reserve(size_t minimum);
+    
+    // Number of buffers allocated so far, including pool fills and overflow
+    uint64_t getAllocationCount() const;
+    
+    // Number of acquire() calls that found every pooled buffer busy
+    uint64_t getOverflowCount() const;
+
+private:
+    size_t capacity;
+    std::vector<cv::Mat> buffers;
+    uint64_t allocations;
+    uint64_t overflows;
+    mutable std::mutex mutex;
+    
+    // True when nobody but the pool holds a reference to the buffer
+    static bool isFree(const cv::Mat& buffer);
+};
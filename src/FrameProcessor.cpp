@@ -0,0 +1,163 @@
+#include "FrameProcessor.h"
+#include "FrameConvert.h"
+#include <iostream>
+
+FrameProcessor::FrameProcessor()
+    : edgeDetectionEnabled(false)
+    , faceDetectionEnabled(false)
+    , depthEstimationEnabled(false)
+    , verbose(true)
+    , faceFrameCount(0)
+    , currentEstimator(nullptr)
+    , precomputedDepthMap(nullptr)
+    , haveDepth(false) {
+    registerStages();
+}
+
+bool FrameProcessor::loadFaceCascade() {
+    // Try to load the frontal face cascade classifier
+    std::vector<std::string> cascadePaths = {
+        "/opt/homebrew/share/opencv4/haarcascades/haarcascade_frontalface_alt.xml",
+        "/usr/local/share/opencv4/haarcascades/haarcascade_frontalface_alt.xml",
+        "/usr/share/opencv4/haarcascades/haarcascade_frontalface_alt.xml",
+        "haarcascade_frontalface_alt.xml"
+    };
+    
+    for (const std::string& path : cascadePaths) {
+        if (faceTracker.loadCascade(path)) {
+            if (verbose) {
+                std::cout << "✅ Face cascade loaded from: " << path << std::endl;
+            }
+            return true;
+        }
+    }
+    
+    std::cerr << "❌ Error: Could not load face cascade classifier" << std::endl;
+    std::cerr << "Make sure OpenCV haarcascades are installed" << std::endl;
+    return false;
+}
+
+void FrameProcessor::prepare(FramePacket& packet) {
+    if (packet.image.empty()) {
+        return;
+    }
+    FrameContext::attach(packet, contextPool);
+    
+    // The gray images edges and faces will read; depth sizes its own input when it runs
+    if (edgeDetectionEnabled) {
+        packet.context->grayLevel(packet, edgeDetector.getPyramidLevel());
+    }
+    if (faceDetectionEnabled && faceTracker.hasCascade()) {
+        packet.context->grayLevel(packet, faceTracker.getPyramidLevel());
+    }
+}
+
+cv::Mat FrameProcessor::process(FramePacket& packet, IDepthEstimator* depthEstimator) {
+    return process(packet, depthEstimator, cv::Mat());
+}
+
+cv::Mat FrameProcessor::process(FramePacket& packet, IDepthEstimator* depthEstimator, const cv::Mat& precomputedDepth) {
+    const cv::Mat& inputFrame = packet.image;
+    if (inputFrame.empty()) {
+        return inputFrame;
+    }
+    
+    // Derived images are computed once per frame and shared by the stages
+    if (!packet.context) {
+        FrameContext::attach(packet, contextPool);
+    }
+    
+    // This frame's inputs to the stages; effects that are off (or can't run) are skipped
+    currentEstimator = depthEstimator;
+    precomputedDepthMap = &precomputedDepth;
+    haveDepth = false;
+    stages.setEnabled("depth", depthEstimationEnabled && depthEstimator && depthEstimator->isInitialized());
+    stages.setEnabled("faces", faceDetectionEnabled && faceTracker.hasCascade());
+    if (!stages.isEnabled("faces")) {
+        faces.clear();
+    }
+    
+    stages.run(packet);
+    
+    currentEstimator = nullptr;
+    precomputedDepthMap = nullptr;
+    packet.markStage(FramePacket::STAGE_PROCESS);
+    return processedBuffer;
+}
+
+void FrameProcessor::registerStages() {
+    // Edges, depth and faces only read the frame, so they run concurrently; compositing
+    // waits for all three
+    stages.addStage("base", {StageGraph::kFrameInput}, {"base"}, [this](FramePacket& packet) {
+        renderBase(packet);
+    });
+    stages.addStage("depth", {StageGraph::kFrameInput}, {"depth"}, [this](FramePacket& packet) {
+        estimateDepth(packet);
+    }, TaskScheduler::PRIORITY_HIGH);
+    stages.addStage("faces", {StageGraph::kFrameInput}, {"faces"}, [this](FramePacket& packet) {
+        trackFaces(packet);
+    });
+    stages.addStage("composite", {"base", "depth", "faces"}, {"composite"}, [this](FramePacket&) {
+        composite();
+    }, TaskScheduler::PRIORITY_LOW);
+}
+
+void FrameProcessor::renderBase(FramePacket& packet) {
+    // Compose into a persistent buffer instead of cloning the input every frame
+    cv::Mat& result = processedBuffer;
+    
+    // Apply edge detection if enabled: tiles across threads, drawn straight into the result
+    // (gray comes straight from luma for raw YUV frames)
+    if (edgeDetectionEnabled) {
+        edgeDetector.render(packet, *packet.context, result);
+    } else if (packet.format == FramePacket::PIXEL_BGR) {
+        packet.image.copyTo(result);
+    } else {
+        // Raw YUV: the one full-resolution colour conversion, straight into the result
+        FrameConvert::toBGR(packet, result);
+    }
+}
+
+void FrameProcessor::estimateDepth(FramePacket& packet) {
+    // Estimate into a reused buffer unless depth was already computed for this packet
+    haveDepth = !precomputedDepthMap->empty() || currentEstimator->estimateDepth(packet, depthBuffer);
+}
+
+void FrameProcessor::trackFaces(FramePacket& packet) {
+    // Full detection every few frames on a downscaled image, template tracking in between
+    faces = faceTracker.update(packet, packet.context->grayLevel(packet, faceTracker.getPyramidLevel()));
+    
+    // Print number of faces detected
+    faceFrameCount++;
+    if (verbose && faceFrameCount % 30 == 0) { // Print every 30 frames to avoid spam
+        std::cout << "Detected " << faces.size() << " face(s)" << std::endl;
+    }
+}
+
+void FrameProcessor::composite() {
+    cv::Mat& result = processedBuffer;
+    if (haveDepth) {
+        // Overlay depth heat map onto the current result in place, keeping the persistent buffer
+        const cv::Mat& depthMap = precomputedDepthMap->empty() ? depthBuffer : *precomputedDepthMap;
+        currentEstimator->blendDepthHeatMap(depthMap, 0.9f, result);
+    }
+    drawFaces(result);
+}
+
+void FrameProcessor::drawFaces(cv::Mat& result) {
+    // Draw bounding boxes around detected faces
+    for (const cv::Rect& face : faces) {
+        cv::rectangle(result, face, cv::Scalar(0, 255, 0), 2);
+        
+        // Add a label
+        std::string label = "Face";
+        int baseline;
+        cv::Size labelSize = cv::getTextSize(label, cv::FONT_HERSHEY_SIMPLEX, 0.5, 1, &baseline);
+        cv::Point labelPos(face.x, face.y - 10);
+        
+        // Ensure label is within frame bounds
+        if (labelPos.y < 0) labelPos.y = face.y + labelSize.height + 10;
+        
+        cv::putText(result, label, labelPos, cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(0, 255, 0), 1);
+    }
+}
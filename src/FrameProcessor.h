@@ -0,0 +1,106 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "FramePacket.h"
+#include "IDepthEstimator.h"
+#include "FaceTracker.h"
+#include "EdgeDetector.h"
+#include "FrameContext.h"
+#include "StageGraph.h"
+
+/**
+ * Applies the demo's computer vision effects (Canny edges, depth heat map, face boxes)
+ * to a captured frame. Each instance owns its own face cascade and scratch buffers, so
+ * one processor per thread lets several streams be processed concurrently.
+ * Packets arriving without a FrameContext get one, so edge detection, face detection and
+ * the depth estimator share a single grayscale conversion and resize of each frame.
+ * The effects are stages of a StageGraph: edges (or the plain frame), depth and faces
+ * run concurrently, then a compositing stage draws depth and faces over the base image.
+ * More stages can be registered through getStageGraph(); one that reads "composite" can
+ * draw on getOutput() after everything else.
+ */
+class FrameProcessor {
+public:
+    FrameProcessor();
+    
+    // Load the frontal face cascade from the usual install locations
+    bool loadFaceCascade();
+    bool hasFaceCascade() const { return faceTracker.hasCascade(); }
+    
+    // Effect toggles (safe to flip from another thread while frames are processed)
+    void setEdgeDetection(bool enabled) { edgeDetectionEnabled = enabled; }
+    void setFaceDetection(bool enabled) { faceDetectionEnabled = enabled; }
+    void setDepthEstimation(bool enabled) { depthEstimationEnabled = enabled; }
+    bool isEdgeDetectionEnabled() const { return edgeDetectionEnabled; }
+    bool isFaceDetectionEnabled() const { return faceDetectionEnabled; }
+    bool isDepthEstimationEnabled() const { return depthEstimationEnabled; }
+    
+    // Print the face count every 30 frames
+    void setVerbose(bool enabled) { verbose = enabled; }
+    
+    /**
+     * Attach a FrameContext to the packet and compute the derived images the enabled
+     * effects will use. Optional: process() attaches a context itself when there is none.
+     * A pipeline can prepare the next frame on another thread while process() runs;
+     * prepare() itself must always be called from the same thread.
+     */
+    void prepare(FramePacket& packet);
+    
+    // Apply the enabled effects and return the composited BGR frame.
+    // `depthEstimator` may be null, in which case depth is skipped. The returned Mat
+    // shares a buffer owned by the processor that is reused on the next call.
+    cv::Mat process(FramePacket& packet, IDepthEstimator* depthEstimator);
+    
+    // As above, but overlay a depth map that was already estimated for this packet
+    // (e.g. as part of a batch) instead of running the estimator
+    cv::Mat process(FramePacket& packet, IDepthEstimator* depthEstimator, const cv::Mat& depthMap);
+    
+    // The stages behind process(), for registering more
+    StageGraph& getStageGraph() { return stages; }
+    
+    // The image process() composes into; valid for stages that read "composite"
+    cv::Mat& getOutput() { return processedBuffer; }
+    
+    // Faces found in the last processed frame
+    const std::vector<cv::Rect>& getFaces() const { return faces; }
+    
+    // Detection interval, scale and timing of the face pipeline
+    FaceTracker& getFaceTracker() { return faceTracker; }
+    const FaceTracker& getFaceTracker() const { return faceTracker; }
+    
+    // Resolution, thresholds and timing of the edge effect
+    EdgeDetector& getEdgeDetector() { return edgeDetector; }
+    const EdgeDetector& getEdgeDetector() const { return edgeDetector; }
+    
+private:
+    std::atomic<bool> edgeDetectionEnabled;
+    std::atomic<bool> faceDetectionEnabled;
+    std::atomic<bool> depthEstimationEnabled;
+    bool verbose;
+    
+    StageGraph stages;
+    EdgeDetector edgeDetector;
+    FaceTracker faceTracker;
+    std::vector<cv::Rect> faces;
+    uint64_t faceFrameCount;
+    
+    // Scratch buffers reused across frames so steady-state processing doesn't reallocate
+    std::vector<std::shared_ptr<FrameContext>> contextPool;
+    cv::Mat processedBuffer;
+    cv::Mat depthBuffer;
+    
+    // The frame being processed, for the stages
+    IDepthEstimator* currentEstimator;
+    const cv::Mat* precomputedDepthMap;  // Points at an empty Mat when depth is estimated here
+    bool haveDepth;
+    
+    void registerStages();
+    void renderBase(FramePacket& packet);
+    void estimateDepth(FramePacket& packet);
+    void trackFaces(FramePacket& packet);
+    void composite();
+    void drawFaces(cv::Mat& result);
+};
@@ -0,0 +1,69 @@
+#include "FrameStats.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+FrameStats::FrameStats(uint64_t reportInterval) : reportInterval(reportInterval) {
+    reset();
+}
+
+void FrameStats::reset() {
+    for (int i = 0; i < FramePacket::STAGE_COUNT; i++) {
+        stages[i].frames = 0;
+        stages[i].dropped = 0;
+        stages[i].lastSequence = 0;
+        stages[i].seenAny = false;
+        stages[i].latencySumMs = 0.0;
+        stages[i].latencyMaxMs = 0.0;
+    }
+    recordedFrames = 0;
+}
+
+void FrameStats::record(const FramePacket& packet) {
+    for (int i = 0; i < FramePacket::STAGE_COUNT; i++) {
+        FramePacket::Stage stage = static_cast<FramePacket::Stage>(i);
+        if (!packet.reachedStage(stage)) {
+            continue;
+        }
+        
+        StageStats& s = stages[i];
+        
+        // Any sequence numbers skipped since the last frame at this stage were dropped upstream
+        if (s.seenAny && packet.sequence > s.lastSequence + 1) {
+            s.dropped += packet.sequence - s.lastSequence - 1;
+        }
+        s.lastSequence = packet.sequence;
+        s.seenAny = true;
+        s.frames++;
+        
+        double latencyMs = packet.stageLatencyMs(stage);
+        if (latencyMs >= 0.0) {
+            s.latencySumMs += latencyMs;
+            if (latencyMs > s.latencyMaxMs) {
+                s.latencyMaxMs = latencyMs;
+            }
+        }
+    }
+    
+    recordedFrames++;
+    if (reportInterval > 0 && recordedFrames % reportInterval == 0) {
+        std::cout << summary() << std::endl;
+    }
+}
+
+std::string FrameStats::summary() const {
+    std::ostringstream out;
+    out << "📊 Frame stats (" << recordedFrames << " frames)";
+    out << std::fixed << std::setprecision(1);
+    for (int i = 1; i < FramePacket::STAGE_COUNT; i++) {
+        const StageStats& s = stages[i];
+        if (s.frames == 0) {
+            continue;
+        }
+        double dropRate = 100.0 * s.dropped / (s.frames + s.dropped);
+        out << "\n  " << std::left << std::setw(8) << FramePacket::stageName(static_cast<FramePacket::Stage>(i))
+            << " latency avg " << (s.latencySumMs / s.frames) << " ms, max " << s.latencyMaxMs
+            << " ms, dropped " << s.dropped << " (" << dropRate << "%)";
+    }
+    return out.str();
+}
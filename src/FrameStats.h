@@ -0,0 +1,38 @@
+#pragma once
+
+#include "FramePacket.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * Collects per-stage latency and dropped-frame statistics from FramePackets.
+ * For each stage it tracks capture-to-stage latency and the sequence numbers seen;
+ * a gap in sequence numbers at a stage counts as frames dropped before that stage.
+ */
+class FrameStats {
+public:
+    // Print a report every `reportInterval` recorded frames (0 disables periodic reports)
+    explicit FrameStats(uint64_t reportInterval = 300);
+    
+    // Record every stage the packet reached; call once the packet is finished with
+    void record(const FramePacket& packet);
+    
+    // Human-readable summary of the statistics since the last reset
+    std::string summary() const;
+    
+    void reset();
+    
+private:
+    struct StageStats {
+        uint64_t frames;
+        uint64_t dropped;
+        uint64_t lastSequence;
+        bool seenAny;
+        double latencySumMs;
+        double latencyMaxMs;
+    };
+    
+    StageStats stages[FramePacket::STAGE_COUNT];
+    uint64_t reportInterval;
+    uint64_t recordedFrames;
+};
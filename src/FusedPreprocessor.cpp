@@ -0,0 +1,138 @@
+#include "FusedPreprocessor.h"
+#include <opencv2/core/hal/intrin.hpp>
+#include <algorithm>
+#include <cmath>
+
+FusedPreprocessor::FusedPreprocessor(cv::Size outputSize, const std::array<float, 3>& mean, const std::array<float, 3>& stdDev)
+    : outputSize(outputSize) {
+    for (int c = 0; c < 3; c++) {
+        channelScale[c] = 1.0f / (255.0f * stdDev[c]);
+        channelBias[c] = -mean[c] / stdDev[c];
+    }
+}
+
+void FusedPreprocessor::buildAxis(int sourceLength, int outputLength, std::vector<int>& index0, std::vector<int>& index1, std::vector<float>& weight) {
+    index0.resize(outputLength);
+    index1.resize(outputLength);
+    weight.resize(outputLength);
+    
+    const double scale = static_cast<double>(sourceLength) / outputLength;
+    for (int d = 0; d < outputLength; d++) {
+        double position = (d + 0.5) * scale - 0.5;
+        int s = static_cast<int>(std::floor(position));
+        float w = static_cast<float>(position - s);
+        if (s < 0) {
+            s = 0;
+            w = 0.0f;
+        }
+        if (s >= sourceLength - 1) {
+            s = sourceLength - 1;
+            w = 0.0f;
+        }
+        index0[d] = s;
+        index1[d] = std::min(s + 1, sourceLength - 1);
+        weight[d] = w;
+    }
+}
+
+void FusedPreprocessor::setOutputSize(cv::Size size) {
+    if (size == outputSize) {
+        return;
+    }
+    outputSize = size;
+    tableSourceSize = cv::Size();
+}
+
+void FusedPreprocessor::buildTables(cv::Size sourceSize) {
+    if (sourceSize == tableSourceSize) {
+        return;
+    }
+    
+    std::vector<int> column0, column1;
+    buildAxis(sourceSize.width, outputSize.width, column0, column1, xWeight);
+    buildAxis(sourceSize.height, outputSize.height, yRow0, yRow1, yWeight);
+    
+    xOffset0.resize(outputSize.width);
+    xOffset1.resize(outputSize.width);
+    for (int x = 0; x < outputSize.width; x++) {
+        xOffset0[x] = column0[x] * 3;
+        xOffset1[x] = column1[x] * 3;
+    }
+    tableSourceSize = sourceSize;
+}
+
+void FusedPreprocessor::run(const cv::Mat& image, bool swapRB, cv::Mat& blob) {
+    const int sizes[] = {1, 3, outputSize.height, outputSize.width};
+    blob.create(4, sizes, CV_32F);
+    run(image, swapRB, blob.ptr<float>());
+}
+
+void FusedPreprocessor::run(const cv::Mat& image, bool swapRB, float* planes) {
+    CV_Assert(image.type() == CV_8UC3);
+    buildTables(image.size());
+    
+    const int width = outputSize.width;
+    const size_t planeSize = static_cast<size_t>(width) * outputSize.height;
+    
+    // Output plane p reads source channel sourceChannel[p]
+    const int sourceChannel[3] = {swapRB ? 2 : 0, 1, swapRB ? 0 : 2};
+    float scale[3], bias[3];
+    for (int p = 0; p < 3; p++) {
+        scale[p] = channelScale[p];
+        bias[p] = channelBias[p];
+    }
+    
+    const int* x0 = xOffset0.data();
+    const int* x1 = xOffset1.data();
+    const float* wx = xWeight.data();
+    
+    cv::parallel_for_(cv::Range(0, outputSize.height), [&](const cv::Range& rows) {
+        // The two source rows of an output row, resampled horizontally into planar order
+        cv::AutoBuffer<float> rowBuffer(static_cast<size_t>(width) * 6);
+        float* topRow = rowBuffer.data();
+        float* bottomRow = topRow + 3 * width;
+        
+        for (int y = rows.start; y < rows.end; y++) {
+            const uchar* top = image.ptr<uchar>(yRow0[y]);
+            const uchar* bottom = image.ptr<uchar>(yRow1[y]);
+            const float wy = yWeight[y];
+            
+            // Horizontal pass: the column tables make this a gather, which stays scalar
+            for (int x = 0; x < width; x++) {
+                const uchar* topLeft = top + x0[x];
+                const uchar* topRight = top + x1[x];
+                const uchar* bottomLeft = bottom + x0[x];
+                const uchar* bottomRight = bottom + x1[x];
+                for (int p = 0; p < 3; p++) {
+                    const int c = sourceChannel[p];
+                    topRow[p * width + x] = topLeft[c] + wx[x] * (topRight[c] - topLeft[c]);
+                    bottomRow[p * width + x] = bottomLeft[c] + wx[x] * (bottomRight[c] - bottomLeft[c]);
+                }
+            }
+            
+            // Vertical blend and normalization folded into out = t * a + u * c + b, over
+            // contiguous rows
+            for (int p = 0; p < 3; p++) {
+                const float* t = topRow + p * width;
+                const float* u = bottomRow + p * width;
+                float* out = planes + p * planeSize + static_cast<size_t>(y) * width;
+                const float a = (1.0f - wy) * scale[p];
+                const float c = wy * scale[p];
+                const float b = bias[p];
+                
+                int x = 0;
+#if CV_SIMD
+                const cv::v_float32 va = cv::vx_setall_f32(a);
+                const cv::v_float32 vc = cv::vx_setall_f32(c);
+                const cv::v_float32 vb = cv::vx_setall_f32(b);
+                for (; x <= width - cv::v_float32::nlanes; x += cv::v_float32::nlanes) {
+                    cv::v_store(out + x, cv::v_fma(cv::vx_load(t + x), va, cv::v_fma(cv::vx_load(u + x), vc, vb)));
+                }
+#endif
+                for (; x < width; x++) {
+                    out[x] = t[x] * a + (u[x] * c + b);
+                }
+            }
+        }
+    });
+}
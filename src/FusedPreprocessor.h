@@ -0,0 +1,54 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <vector>
+
+/**
+ * Builds a normalized planar (NCHW) float blob from an 8-bit 3-channel image in one pass.
+ * Bilinear resize, channel swap, 1/255 scaling, mean/std normalization and the HWC to CHW
+ * transpose are fused, so the source is read once and nothing is written but the blob.
+ * Rows are split across threads with cv::parallel_for_. Each output row is built in two
+ * steps: a horizontal pass gathers the source pixels through precomputed column tables
+ * (scalar, since the samples aren't contiguous), then the vertical blend and normalization
+ * run over contiguous rows with OpenCV's universal intrinsics.
+ * Resampling follows cv::resize(INTER_LINEAR) pixel-centre mapping but without the 8-bit
+ * rounding step, so results match the resize/cvtColor/normalize chain to within about
+ * half a grey level.
+ */
+class FusedPreprocessor {
+public:
+    FusedPreprocessor(cv::Size outputSize, const std::array<float, 3>& mean, const std::array<float, 3>& stdDev);
+    
+    /**
+     * Write a 1 x 3 x H x W blob for `image`.
+     * @param swapRB true if `image` is BGR and the model wants RGB
+     */
+    void run(const cv::Mat& image, bool swapRB, cv::Mat& blob);
+    
+    // Write the three H x W planes for `image` into `planes` (one batch entry of a larger blob)
+    void run(const cv::Mat& image, bool swapRB, float* planes);
+    
+    cv::Size getOutputSize() const { return outputSize; }
+    
+    // Change the blob size; the interpolation tables are rebuilt on the next run()
+    void setOutputSize(cv::Size size);
+    
+    // Source sample positions and weights for one axis of a bilinear resize, using
+    // cv::resize's pixel-centre convention (index1 is index0's neighbour, clamped at the edge)
+    static void buildAxis(int sourceLength, int outputLength, std::vector<int>& index0, std::vector<int>& index1, std::vector<float>& weight);
+    
+private:
+    cv::Size outputSize;
+    float channelScale[3];  // 1 / (255 * std)
+    float channelBias[3];   // -mean / std
+    
+    // Interpolation tables for the last source size seen
+    cv::Size tableSourceSize;
+    std::vector<int> xOffset0, xOffset1;  // Byte offsets of the left/right source pixels
+    std::vector<float> xWeight;           // Weight of the right pixel
+    std::vector<int> yRow0, yRow1;
+    std::vector<float> yWeight;
+    
+    void buildTables(cv::Size sourceSize);
+};
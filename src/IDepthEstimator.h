@@ -2,6 +2,10 @@
 
 #include <opencv2/opencv.hpp>
 #include <string>
+#include <cstdint>
+#include <vector>
+#include "FramePacket.h"
+#include "FrameConvert.h"
 
 /**
  * Abstract interface for depth estimation implementations.
@@ -17,12 +21,50 @@ public:
     // Estimate depth from input image and return depth map
     virtual cv::Mat estimateDepth(const cv::Mat& inputImage) = 0;
     
+    // Estimate depth for a captured packet (any pixel format), stamping the packet when depth is ready
+    virtual cv::Mat estimateDepth(FramePacket& packet) {
+        cv::Mat bgr;
+        FrameConvert::toBGR(packet, bgr);
+        cv::Mat depthMap = estimateDepth(bgr);
+        if (!depthMap.empty()) {
+            packet.markStage(FramePacket::STAGE_DEPTH);
+        }
+        return depthMap;
+    }
+    
+    // Estimate depth into a caller-owned buffer, reusing it when it already has the right size.
+    // Returns false if no depth map was produced.
+    virtual bool estimateDepth(FramePacket& packet, cv::Mat& depthMap) {
+        depthMap = estimateDepth(packet);
+        return !depthMap.empty();
+    }
+    
+    // Mat buffers allocated by the last depth estimate on any thread; 0 if unknown (see AllocationCounter)
+    virtual uint64_t getLastFrameAllocationCount() const { return 0; }
+    
+    // Estimate depth for several packets (different streams or consecutive frames) in one go.
+    // Returns one depth map per packet, in order; entries are empty where estimation failed.
+    // The default runs them one at a time; batching estimators pack them into a single pass.
+    virtual std::vector<cv::Mat> estimateDepthBatch(std::vector<FramePacket>& packets) {
+        std::vector<cv::Mat> depthMaps;
+        for (FramePacket& packet : packets) {
+            depthMaps.push_back(estimateDepth(packet));
+        }
+        return depthMaps;
+    }
+    
     // Create a colorized heat map from depth data
     virtual cv::Mat createDepthHeatMap(const cv::Mat& depthMap) = 0;
     
     // Overlay depth heat map on original image
     virtual cv::Mat overlayDepthHeatMap(const cv::Mat& originalImage, const cv::Mat& depthMap, float alpha = 0.6f) = 0;
     
+    // Overlay the heat map onto `frame` itself. The default goes through overlayDepthHeatMap();
+    // estimators that can blend into the destination override it and allocate no new frame.
+    virtual void blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) {
+        frame = overlayDepthHeatMap(frame, depthMap, alpha);
+    }
+    
     // Check if estimator is ready
     virtual bool isInitialized() const = 0;
     
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <opencv2/opencv.hpp>
+#include <chrono>
 #include <string>
+#include <cstdint>
+#include "FramePacket.h"
 
 /**
  * Simple interface for webcam capture.
@@ -14,8 +17,18 @@ public:
     // Initialize the webcam
     virtual bool initialize() = 0;
     
+    // Capture a frame together with its capture timestamp, sequence number and source ID
+    virtual bool capturePacket(FramePacket& packet) = 0;
+    
     // Capture a frame from the webcam
-    virtual bool captureFrame(cv::Mat& frame) = 0;
+    bool captureFrame(cv::Mat& frame) {
+        FramePacket packet;
+        if (!capturePacket(packet)) {
+            return false;
+        }
+        frame = packet.image;
+        return true;
+    }
     
     // Check if webcam is active/initialized
     virtual bool isActive() const = 0;
@@ -25,4 +38,38 @@ public:
     
     // Get frame dimensions
     virtual cv::Size getFrameSize() const = 0;
+    
+    // Number of captured frames that were replaced by a newer one before being read
+    virtual uint64_t getDroppedFrameCount() const { return 0; }
+    
+    // Number of frame buffers the source has allocated; stays flat in steady state for pooled sources
+    virtual uint64_t getBufferAllocationCount() const { return 0; }
+    
+    // Let pooled sources keep enough buffers for a consumer holding up to `frames` frames
+    // at once (queued frames included), so the pool doesn't overflow and allocate every frame
+    virtual void reserveFrameBuffers(size_t frames) { (void)frames; }
+    
+    // Wait up to `timeout` for a frame to be ready; sources that produce frames on demand
+    // return true straight away and let capturePacket() do the waiting
+    virtual bool waitForFrame(std::chrono::milliseconds timeout) { (void)timeout; return true; }
+    
+    // Time the source took to initialize, in milliseconds
+    virtual double getStartupTimeMs() const { return 0.0; }
+    
+    // Source ID stamped into every packet (distinguishes streams sharing a pipeline)
+    void setSourceId(int id) { sourceId = id; }
+    int getSourceId() const { return sourceId; }
+
+protected:
+    int sourceId = 0;
+    uint64_t nextSequence = 0;
+    
+    // Fill in sequence number, source ID and capture time for a freshly captured frame
+    void stampPacket(FramePacket& packet) {
+        packet.clearStages();
+        packet.context.reset();  // Derived images of the previous frame
+        packet.sequence = nextSequence++;
+        packet.sourceId = sourceId;
+        packet.markStage(FramePacket::STAGE_CAPTURE);
+    }
 };
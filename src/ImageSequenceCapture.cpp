@@ -0,0 +1,136 @@
+#include "ImageSequenceCapture.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+bool hasImageExtension(const std::string& file) {
+    size_t dot = file.find_last_of('.');
+    if (dot == std::string::npos) {
+        return false;
+    }
+    
+    std::string ext = file.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "bmp" || ext == "ppm" || ext == "tif" || ext == "tiff";
+}
+
+// Read a whole file into `buffer` with unbuffered reads: no stream object or stdio buffer
+// is allocated per frame, and `buffer` only grows when a file is larger than any before it
+bool readFile(const char* path, std::vector<uchar>& buffer) {
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    bool ok = ::fstat(fd, &info) == 0 && info.st_size > 0;
+    if (ok) {
+        buffer.resize(static_cast<size_t>(info.st_size));
+        size_t total = 0;
+        while (ok && total < buffer.size()) {
+            const ssize_t count = ::read(fd, buffer.data() + total, buffer.size() - total);
+            ok = count > 0;
+            total += ok ? static_cast<size_t>(count) : 0;
+        }
+    }
+    ::close(fd);
+    return ok;
+}
+
+}
+
+ImageSequenceCapture::ImageSequenceCapture(const std::string& directory, double fps, bool realTime, bool loop)
+    : directory(directory), nextIndex(0), pacer(fps, realTime), loop(loop), active(false) {
+}
+
+ImageSequenceCapture::~ImageSequenceCapture() {
+    release();
+}
+
+bool ImageSequenceCapture::initialize() {
+    std::cout << "Scanning image sequence: " << directory << std::endl;
+    
+    std::vector<cv::String> candidates;
+    try {
+        cv::glob(directory + "/*", candidates, false);
+    } catch (const cv::Exception& e) {
+        std::cerr << "❌ Error: Could not list " << directory << ": " << e.what() << std::endl;
+        return false;
+    }
+    
+    files.clear();
+    for (const cv::String& file : candidates) {
+        if (hasImageExtension(file)) {
+            files.push_back(file);
+        }
+    }
+    std::sort(files.begin(), files.end());
+    
+    if (files.empty()) {
+        std::cerr << "❌ Error: No images found in " << directory << std::endl;
+        return false;
+    }
+    
+    cv::Mat first = cv::imread(files[0]);
+    if (first.empty()) {
+        std::cerr << "❌ Error: Could not read " << files[0] << std::endl;
+        return false;
+    }
+    
+    frameSize = first.size();
+    nextIndex = 0;
+    pacer.reset();
+    
+    std::cout << "✅ Image sequence loaded: " << files.size() << " frames, "
+              << frameSize.width << "x" << frameSize.height
+              << (pacer.isRealTime() ? " (real-time)" : " (as fast as possible)") << std::endl;
+    active = true;
+    return true;
+}
+
+bool ImageSequenceCapture::capturePacket(FramePacket& packet) {
+    if (!active) {
+        return false;
+    }
+    
+    if (nextIndex >= files.size()) {
+        if (!loop) {
+            return false;
+        }
+        nextIndex = 0;
+    }
+    
+    pacer.waitForNextFrame();
+    
+    // Read the encoded file into a reused byte buffer
+    const cv::String& path = files[nextIndex++];
+    if (!readFile(path.c_str(), fileBuffer)) {
+        std::cerr << "❌ Error: Could not read " << path << std::endl;
+        return false;
+    }
+    
+    // Decode into a pooled buffer; imdecode reuses it when the geometry matches. The pooled
+    // buffer still holds an earlier frame, so only the returned image says whether decoding worked.
+    packet.image = framePool.acquire(frameSize, CV_8UC3);
+    cv::Mat decoded = cv::imdecode(fileBuffer, cv::IMREAD_COLOR, &packet.image);
+    if (decoded.empty()) {
+        std::cerr << "❌ Error: Could not decode " << path << std::endl;
+        packet.image.release();
+        return false;
+    }
+    packet.image = decoded;
+    stampPacket(packet);
+    return true;
+}
+
+void ImageSequenceCapture::release() {
+    files.clear();
+    framePool.clear();
+    nextIndex = 0;
+    active = false;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+#include "IWebcamCapture.h"
+#include "FramePacer.h"
+#include "FramePool.h"
+
+/**
+ * Plays back a directory of images (sorted by file name) through the webcam interface.
+ */
+class ImageSequenceCapture : public IWebcamCapture {
+public:
+    ImageSequenceCapture(const std::string& directory, double fps = 30.0, bool realTime = true, bool loop = true);
+    ~ImageSequenceCapture() override;
+    
+    // Scan the directory for images
+    bool initialize() override;
+    
+    // Load the next image in the sequence
+    bool capturePacket(FramePacket& packet) override;
+    
+    // Check if the sequence is loaded
+    bool isActive() const override { return active; }
+    
+    // Forget the sequence
+    void release() override;
+    
+    // Get frame dimensions (size of the first image)
+    cv::Size getFrameSize() const override { return frameSize; }
+    
+    // Frame buffers allocated by the decode pool
+    uint64_t getBufferAllocationCount() const override { return framePool.getAllocationCount(); }
+    void reserveFrameBuffers(size_t frames) override { framePool.reserve(frames); }
+    
+private:
+    std::string directory;
+    std::vector<cv::String> files;
+    size_t nextIndex;
+    FramePacer pacer;
+    FramePool framePool;
+    std::vector<uchar> fileBuffer;  // Encoded bytes of the current file, reused between frames
+    cv::Size frameSize;
+    bool loop;
+    bool active;
+};
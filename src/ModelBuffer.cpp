@@ -0,0 +1,95 @@
+#include "ModelBuffer.h"
+#include <fstream>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MODEL_BUFFER_MMAP 1
+#endif
+
+std::mutex ModelBuffer::registryMutex;
+std::map<std::string, std::weak_ptr<ModelBuffer>> ModelBuffer::registry;
+
+ModelBuffer::ModelBuffer(const std::string& path)
+    : path(path), bytes(nullptr), length(0), mapped(false) {
+}
+
+ModelBuffer::~ModelBuffer() {
+#ifdef MODEL_BUFFER_MMAP
+    if (mapped) {
+        munmap(const_cast<char*>(bytes), length);
+        return;
+    }
+#endif
+    delete[] bytes;
+}
+
+std::shared_ptr<ModelBuffer> ModelBuffer::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    
+    std::shared_ptr<ModelBuffer> buffer = registry[path].lock();
+    if (buffer) {
+        return buffer;
+    }
+    
+    buffer = std::shared_ptr<ModelBuffer>(new ModelBuffer(path));
+    if (!buffer->load()) {
+        registry.erase(path);
+        return std::shared_ptr<ModelBuffer>();
+    }
+    registry[path] = buffer;
+    return buffer;
+}
+
+void ModelBuffer::releasePages() {
+#ifdef MODEL_BUFFER_MMAP
+    if (mapped) {
+        madvise(const_cast<char*>(bytes), length, MADV_DONTNEED);
+    }
+#endif
+}
+
+bool ModelBuffer::load() {
+#ifdef MODEL_BUFFER_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            bytes = static_cast<const char*>(address);
+            length = static_cast<size_t>(info.st_size);
+            mapped = true;
+        }
+    }
+    ::close(fd);  // The mapping stays valid without the descriptor
+    if (mapped) {
+        return true;
+    }
+#endif
+    
+    // No mmap (or it failed): read the whole file once
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        return false;
+    }
+    std::streamsize fileSize = file.tellg();
+    if (fileSize <= 0) {
+        return false;
+    }
+    char* contents = new char[static_cast<size_t>(fileSize)];
+    file.seekg(0);
+    if (!file.read(contents, fileSize)) {
+        delete[] contents;
+        return false;
+    }
+    bytes = contents;
+    length = static_cast<size_t>(fileSize);
+    return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * Read-only memory mapping of a model file, shared by everything in the process that
+ * loads the same path.
+ * open() returns the existing mapping while any user still holds it, so several depth
+ * estimators (a pool, an adaptive ladder, the backend benchmark) read the file from the
+ * same pages instead of each pulling their own copy off disk. The mapping is released
+ * when the last holder lets go.
+ * Where mmap isn't available the file is read into memory once instead.
+ */
+class ModelBuffer {
+public:
+    ~ModelBuffer();
+    
+    /**
+     * Map `path`, or share the mapping another caller already has.
+     * @return The mapping, or nullptr if the file can't be opened or is empty
+     */
+    static std::shared_ptr<ModelBuffer> open(const std::string& path);
+    
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+    const std::string& getPath() const { return path; }
+    
+    // True if the file is memory-mapped rather than copied into memory
+    bool isMapped() const { return mapped; }
+    
+    // Hint that the bytes have been parsed: the pages drop out of this process's resident
+    // set and are read back from the page cache if anyone touches them again
+    void releasePages();
+    
+private:
+    std::string path;
+    const char* bytes;
+    size_t length;
+    bool mapped;
+    
+    explicit ModelBuffer(const std::string& path);
+    bool load();
+    
+    ModelBuffer(const ModelBuffer&) = delete;
+    ModelBuffer& operator=(const ModelBuffer&) = delete;
+    
+    // Live mappings by path
+    static std::mutex registryMutex;
+    static std::map<std::string, std::weak_ptr<ModelBuffer>> registry;
+};
@@ -0,0 +1,124 @@
+#include "MotionGatedDepthEstimator.h"
+#include <sstream>
+
+namespace {
+
+// Thumbnail used for change detection; small enough that the comparison is negligible
+const cv::Size kThumbnailSize(64, 48);
+
+}
+
+MotionGatedDepthEstimator::MotionGatedDepthEstimator(std::unique_ptr<IDepthEstimator> estimator)
+    : estimator(std::move(estimator))
+    , motionThreshold(2.0)
+    , refreshInterval(30)
+    , estimatedCount(0)
+    , skippedCount(0) {
+}
+
+bool MotionGatedDepthEstimator::needsInference(const FramePacket& packet, SourceState& state) {
+    // Start from a quarter-size level of the frame's pyramid, which other stages share
+    const cv::Mat& gray = FrameContext::of(packet, localFrame).grayLevel(packet, 2);
+    cv::resize(gray, thumbnail, kThumbnailSize, 0, 0, cv::INTER_AREA);
+    
+    if (motionThreshold <= 0.0 || state.depthMap.empty() || state.framesSinceRefresh + 1 >= refreshInterval ||
+        state.reference.size() != thumbnail.size()) {
+        return true;
+    }
+    
+    cv::absdiff(thumbnail, state.reference, difference);
+    return cv::mean(difference)[0] >= motionThreshold;
+}
+
+void MotionGatedDepthEstimator::storeEstimate(SourceState& state, const cv::Mat& depthMap) {
+    // Compare future frames against the one this depth belongs to, so slow drift adds up
+    thumbnail.copyTo(state.reference);
+    depthMap.copyTo(state.depthMap);
+    state.framesSinceRefresh = 0;
+    estimatedCount++;
+}
+
+cv::Mat MotionGatedDepthEstimator::estimateDepth(const cv::Mat& inputImage) {
+    FramePacket packet;
+    packet.image = inputImage;
+    return estimateDepth(packet);
+}
+
+cv::Mat MotionGatedDepthEstimator::estimateDepth(FramePacket& packet) {
+    cv::Mat depthMap;
+    estimateDepth(packet, depthMap);
+    return depthMap;
+}
+
+bool MotionGatedDepthEstimator::estimateDepth(FramePacket& packet, cv::Mat& depthMap) {
+    if (packet.image.empty()) {
+        return false;
+    }
+    
+    SourceState& state = sources[packet.sourceId];
+    if (needsInference(packet, state)) {
+        if (!estimator->estimateDepth(packet, depthMap)) {
+            return false;
+        }
+        storeEstimate(state, depthMap);
+        return true;
+    }
+    
+    // Scene is still: reuse the last depth map for this source
+    state.depthMap.copyTo(depthMap);
+    state.framesSinceRefresh++;
+    skippedCount++;
+    packet.markStage(FramePacket::STAGE_DEPTH);
+    return true;
+}
+
+std::vector<cv::Mat> MotionGatedDepthEstimator::estimateDepthBatch(std::vector<FramePacket>& packets) {
+    std::vector<cv::Mat> depthMaps(packets.size());
+    std::vector<FramePacket> moving;
+    std::vector<size_t> movingIndices;
+    std::vector<cv::Mat> movingThumbnails;
+    
+    for (size_t i = 0; i < packets.size(); i++) {
+        if (packets[i].image.empty()) {
+            continue;
+        }
+        SourceState& state = sources[packets[i].sourceId];
+        if (needsInference(packets[i], state)) {
+            moving.push_back(packets[i]);
+            movingIndices.push_back(i);
+            movingThumbnails.push_back(thumbnail.clone());
+        } else {
+            state.depthMap.copyTo(depthMaps[i]);
+            state.framesSinceRefresh++;
+            skippedCount++;
+            packets[i].markStage(FramePacket::STAGE_DEPTH);
+        }
+    }
+    
+    if (!moving.empty()) {
+        std::vector<cv::Mat> estimated = estimator->estimateDepthBatch(moving);
+        for (size_t m = 0; m < moving.size(); m++) {
+            size_t i = movingIndices[m];
+            packets[i].stageTimeNs[FramePacket::STAGE_DEPTH] = moving[m].stageTimeNs[FramePacket::STAGE_DEPTH];
+            if (estimated[m].empty()) {
+                continue;
+            }
+            depthMaps[i] = estimated[m];
+            thumbnail = movingThumbnails[m];
+            storeEstimate(sources[packets[i].sourceId], estimated[m]);
+        }
+    }
+    return depthMaps;
+}
+
+double MotionGatedDepthEstimator::getSkipRate() const {
+    uint64_t total = estimatedCount + skippedCount;
+    return total > 0 ? static_cast<double>(skippedCount) / total : 0.0;
+}
+
+std::string MotionGatedDepthEstimator::summary() const {
+    std::ostringstream out;
+    out << "Depth inference ran on " << estimatedCount << " frame(s), reused depth on " << skippedCount
+        << " (" << static_cast<int>(getSkipRate() * 100.0 + 0.5) << "% skipped)";
+    return out.str();
+}
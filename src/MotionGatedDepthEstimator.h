@@ -0,0 +1,88 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include "IDepthEstimator.h"
+#include "FrameContext.h"
+
+/**
+ * Skips depth inference when the scene hasn't changed.
+ * Each frame is reduced to a small grayscale thumbnail and compared with the thumbnail of
+ * the last frame that was actually estimated. If the mean absolute difference is below
+ * the threshold, the previous depth map is reused; a refresh is forced every N frames so
+ * slow changes still come through. State is kept per source ID, so one gate can serve
+ * several streams.
+ */
+class MotionGatedDepthEstimator : public IDepthEstimator {
+public:
+    // Takes ownership of `estimator`
+    explicit MotionGatedDepthEstimator(std::unique_ptr<IDepthEstimator> estimator);
+    
+    // Mean absolute thumbnail difference (0-255 gray levels) below which depth is reused.
+    // 0 disables gating.
+    void setMotionThreshold(double threshold) { motionThreshold = threshold; }
+    double getMotionThreshold() const { return motionThreshold; }
+    
+    // Run inference at least every `frames` frames per source, however still the scene
+    void setRefreshInterval(int frames) { refreshInterval = std::max(1, frames); }
+    
+    bool initialize(const std::string& modelPath = "") override { return estimator->initialize(modelPath); }
+    
+    cv::Mat estimateDepth(const cv::Mat& inputImage) override;
+    cv::Mat estimateDepth(FramePacket& packet) override;
+    bool estimateDepth(FramePacket& packet, cv::Mat& depthMap) override;
+    
+    // Frames that moved are estimated together in one batch; the rest reuse their stream's depth
+    std::vector<cv::Mat> estimateDepthBatch(std::vector<FramePacket>& packets) override;
+    
+    uint64_t getLastFrameAllocationCount() const override { return estimator->getLastFrameAllocationCount(); }
+    
+    cv::Mat createDepthHeatMap(const cv::Mat& depthMap) override { return estimator->createDepthHeatMap(depthMap); }
+    cv::Mat overlayDepthHeatMap(const cv::Mat& originalImage, const cv::Mat& depthMap, float alpha = 0.6f) override {
+        return estimator->overlayDepthHeatMap(originalImage, depthMap, alpha);
+    }
+    void blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) override {
+        estimator->blendDepthHeatMap(depthMap, alpha, frame);
+    }
+    
+    bool isInitialized() const override { return estimator->isInitialized(); }
+    std::string getDescription() const override { return estimator->getDescription() + " (motion gated)"; }
+    
+    // Frames that ran inference and frames that reused the previous depth map
+    uint64_t getEstimatedCount() const { return estimatedCount; }
+    uint64_t getSkippedCount() const { return skippedCount; }
+    double getSkipRate() const;
+    std::string summary() const;
+    
+private:
+    // Per-source gate state
+    struct SourceState {
+        cv::Mat reference;  // Thumbnail of the last estimated frame
+        cv::Mat depthMap;   // Its depth map
+        int framesSinceRefresh = 0;
+    };
+    
+    std::unique_ptr<IDepthEstimator> estimator;
+    double motionThreshold;
+    int refreshInterval;
+    std::map<int, SourceState> sources;
+    
+    // Scratch buffers for the change detector
+    FrameContext localFrame;  // For packets without a context of their own
+    cv::Mat thumbnail;
+    cv::Mat difference;
+    
+    std::atomic<uint64_t> estimatedCount;
+    std::atomic<uint64_t> skippedCount;
+    
+    // Build the packet's thumbnail and decide whether it needs inference
+    bool needsInference(const FramePacket& packet, SourceState& state);
+    
+    // Record a fresh estimate for a source
+    void storeEstimate(SourceState& state, const cv::Mat& depthMap);
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Process resource usage as reported by the operating system.
+ * Returns 0 where the platform doesn't expose a figure.
+ */
+class ResourceUsage {
+public:
+    // Current resident set size of the process in bytes
+    static uint64_t residentBytes();
+};
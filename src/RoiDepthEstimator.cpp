@@ -0,0 +1,145 @@
+#include "RoiDepthEstimator.h"
+#include <algorithm>
+
+RoiDepthEstimator::RoiDepthEstimator(std::unique_ptr<IDepthEstimator> estimator)
+    : estimator(std::move(estimator))
+    , enabled(false)
+    , maxRegions(2)
+    , maxOutputWidth(640)
+    , regionMargin(0.25f)
+    , featherWidth(0.2f) {
+}
+
+void RoiDepthEstimator::setRegions(const std::vector<cv::Rect>& newRegions) {
+    std::lock_guard<std::mutex> lock(regionMutex);
+    regions = newRegions;
+}
+
+void RoiDepthEstimator::setEnabled(bool enable) {
+    std::lock_guard<std::mutex> lock(regionMutex);
+    enabled = enable;
+}
+
+bool RoiDepthEstimator::isEnabled() const {
+    std::lock_guard<std::mutex> lock(regionMutex);
+    return enabled;
+}
+
+cv::Mat RoiDepthEstimator::estimateDepth(const cv::Mat& inputImage) {
+    FramePacket packet;
+    packet.image = inputImage;
+    return estimateDepth(packet);
+}
+
+cv::Mat RoiDepthEstimator::estimateDepth(FramePacket& packet) {
+    cv::Mat depthMap;
+    estimateDepth(packet, depthMap);
+    return depthMap;
+}
+
+bool RoiDepthEstimator::estimateDepth(FramePacket& packet, cv::Mat& depthMap) {
+    std::vector<cv::Rect> activeRegions;
+    {
+        std::lock_guard<std::mutex> lock(regionMutex);
+        if (enabled) {
+            activeRegions = regions;
+        }
+    }
+    
+    if (activeRegions.empty()) {
+        return estimator->estimateDepth(packet, depthMap);
+    }
+    
+    // Low-resolution depth for the whole frame
+    if (!estimator->estimateDepth(packet, fullDepth)) {
+        return false;
+    }
+    
+    // Upsample it to the output resolution, which is where region detail lands
+    const cv::Size frameSize = packet.imageSize();
+    const double outputScale = std::min(1.0, static_cast<double>(maxOutputWidth) / frameSize.width);
+    const cv::Size outputSize(cvRound(frameSize.width * outputScale), cvRound(frameSize.height * outputScale));
+    cv::resize(fullDepth, depthMap, outputSize, 0, 0, cv::INTER_LINEAR);
+    
+    // Regions are cropped from the BGR frame (a shallow view unless the frame is raw YUV)
+    const cv::Mat& bgrFrame = FrameContext::of(packet, localFrame).bgr(packet);
+    const cv::Rect frameRect(0, 0, bgrFrame.cols, bgrFrame.rows);
+    
+    // Biggest regions first: they're the subjects closest to the camera
+    std::sort(activeRegions.begin(), activeRegions.end(), [](const cv::Rect& a, const cv::Rect& b) {
+        return a.area() > b.area();
+    });
+    
+    size_t refined = 0;
+    for (const cv::Rect& region : activeRegions) {
+        if (refined >= maxRegions) {
+            break;
+        }
+        
+        // Add some context around the region so its depth isn't judged in isolation
+        int marginX = cvRound(region.width * regionMargin);
+        int marginY = cvRound(region.height * regionMargin);
+        cv::Rect crop = cv::Rect(region.x - marginX, region.y - marginY,
+                                 region.width + 2 * marginX, region.height + 2 * marginY) & frameRect;
+        if (crop.width < 16 || crop.height < 16) {
+            continue;
+        }
+        
+        FramePacket cropPacket;
+        cropPacket.image = bgrFrame(crop);
+        cropPacket.format = FramePacket::PIXEL_BGR;
+        cropPacket.sourceId = packet.sourceId;
+        if (!estimator->estimateDepth(cropPacket, regionDepth)) {
+            continue;
+        }
+        
+        cv::Rect outputRect(cvRound(crop.x * outputScale), cvRound(crop.y * outputScale),
+                            cvRound(crop.width * outputScale), cvRound(crop.height * outputScale));
+        outputRect &= cv::Rect(0, 0, outputSize.width, outputSize.height);
+        if (outputRect.width < 4 || outputRect.height < 4) {
+            continue;
+        }
+        
+        cv::resize(regionDepth, regionResized, outputRect.size(), 0, 0, cv::INTER_LINEAR);
+        blendRegion(regionResized, depthMap(outputRect));
+        refined++;
+    }
+    
+    packet.markStage(FramePacket::STAGE_DEPTH);
+    return true;
+}
+
+void RoiDepthEstimator::blendRegion(const cv::Mat& region, cv::Mat target) {
+    // Least-squares scale and shift mapping the region's relative depth onto the full-frame depth
+    cv::Scalar regionMean, regionStdDev, targetMean;
+    cv::meanStdDev(region, regionMean, regionStdDev);
+    targetMean = cv::mean(target);
+    cv::multiply(region, target, regionProduct);
+    double covariance = cv::mean(regionProduct)[0] - regionMean[0] * targetMean[0];
+    double variance = regionStdDev[0] * regionStdDev[0];
+    double scale = variance > 1e-12 ? covariance / variance : 1.0;
+    double shift = targetMean[0] - scale * regionMean[0];
+    
+    // Weights are 1 in the middle and fade to 0 at the edges, so no seam shows
+    blendWeights.create(region.size(), CV_32F);
+    const float featherX = std::max(1.0f, region.cols * featherWidth);
+    const float featherY = std::max(1.0f, region.rows * featherWidth);
+    for (int y = 0; y < region.rows; y++) {
+        float* weightRow = blendWeights.ptr<float>(y);
+        const float wy = std::min(1.0f, std::min(y + 0.5f, region.rows - y - 0.5f) / featherY);
+        for (int x = 0; x < region.cols; x++) {
+            const float wx = std::min(1.0f, std::min(x + 0.5f, region.cols - x - 0.5f) / featherX);
+            weightRow[x] = wx * wy;
+        }
+    }
+    
+    for (int y = 0; y < region.rows; y++) {
+        const float* regionRow = region.ptr<float>(y);
+        const float* weightRow = blendWeights.ptr<float>(y);
+        float* targetRow = target.ptr<float>(y);
+        for (int x = 0; x < region.cols; x++) {
+            const float fitted = static_cast<float>(regionRow[x] * scale + shift);
+            targetRow[x] += weightRow[x] * (fitted - targetRow[x]);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "IDepthEstimator.h"
+#include "FrameContext.h"
+
+/**
+ * Adds detail to selected regions of the depth map.
+ * The full frame is estimated at model resolution as usual; each region of interest
+ * (e.g. a detected face) is then cropped and estimated on its own, so the model's full
+ * input resolution goes to that region. Relative depth from separate passes has its own
+ * scale and shift, so each region is least-squares fitted to the full-frame map before
+ * being blended in with feathered edges. The result is returned at up to
+ * `maxOutputWidth` pixels wide so the regions keep their extra detail.
+ */
+class RoiDepthEstimator : public IDepthEstimator {
+public:
+    // Takes ownership of `estimator`
+    explicit RoiDepthEstimator(std::unique_ptr<IDepthEstimator> estimator);
+    
+    // Regions to refine, in frame coordinates. Safe to call from any thread; used from the next estimate on.
+    void setRegions(const std::vector<cv::Rect>& regions);
+    
+    // Turn refinement on or off (off passes frames straight through)
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    
+    // Most regions refined per frame; each costs one extra inference
+    void setMaxRegions(size_t count) { maxRegions = count; }
+    
+    bool initialize(const std::string& modelPath = "") override { return estimator->initialize(modelPath); }
+    
+    cv::Mat estimateDepth(const cv::Mat& inputImage) override;
+    cv::Mat estimateDepth(FramePacket& packet) override;
+    bool estimateDepth(FramePacket& packet, cv::Mat& depthMap) override;
+    
+    uint64_t getLastFrameAllocationCount() const override { return estimator->getLastFrameAllocationCount(); }
+    
+    cv::Mat createDepthHeatMap(const cv::Mat& depthMap) override { return estimator->createDepthHeatMap(depthMap); }
+    cv::Mat overlayDepthHeatMap(const cv::Mat& originalImage, const cv::Mat& depthMap, float alpha = 0.6f) override {
+        return estimator->overlayDepthHeatMap(originalImage, depthMap, alpha);
+    }
+    void blendDepthHeatMap(const cv::Mat& depthMap, float alpha, cv::Mat& frame) override {
+        estimator->blendDepthHeatMap(depthMap, alpha, frame);
+    }
+    
+    bool isInitialized() const override { return estimator->isInitialized(); }
+    std::string getDescription() const override { return estimator->getDescription() + " (ROI refined)"; }
+    
+private:
+    std::unique_ptr<IDepthEstimator> estimator;
+    
+    mutable std::mutex regionMutex;  // Guards regions and enabled
+    std::vector<cv::Rect> regions;
+    bool enabled;
+    
+    size_t maxRegions;
+    int maxOutputWidth;
+    float regionMargin;   // Fraction of the region size added on each side for context
+    float featherWidth;   // Fraction of the region size over which the blend fades out
+    
+    // Scratch buffers reused across frames
+    cv::Mat fullDepth;
+    FrameContext localFrame;  // For packets without a context of their own
+    cv::Mat regionDepth;
+    cv::Mat regionResized;
+    cv::Mat blendWeights;
+    cv::Mat regionProduct;  // region * target, for the fit's covariance
+    
+    // Fit `region` (already at output size) to the full-frame depth in `target`, a view of the
+    // same area, by least-squares scale and shift, and blend the fitted depth into `target`
+    void blendRegion(const cv::Mat& region, cv::Mat target);
+};
@@ -13,7 +13,10 @@
 #endif
 
 SimpleCubeViewer::SimpleCubeViewer()
-    : cameraDistance(5.0f)
+    : vertices(nullptr)
+    , texCoords(nullptr)
+    , indices(nullptr)
+    , cameraDistance(5.0f)
     , cameraTheta(0.0f)
     , cameraPhi(0.0f)
     , lastMouseX(0.0)
@@ -21,16 +24,32 @@ SimpleCubeViewer::SimpleCubeViewer()
     , firstMouse(true)
     , windowWidth(800)
     , windowHeight(600)
+    , depthGate(nullptr)
+    , depthQuality(nullptr)
+    , meshDepthSequence(0)
+    , meshHasDepth(false)
+    , meshUpdatePending(false)
     , textureID(0)
     , webcamActive(false)
     , depthEstimatorActive(false)
-    , vertices(nullptr)
-    , texCoords(nullptr)
-    , indices(nullptr)
+    , sourceSpec("camera")
+    , realTimeSource(true)
+    , autoSelectBackend(false)
+    , depthBudgetMs(0.0)
+    , depthTier(DepthEstimatorFactory::TIER_AUTO)
+    , processedFrames(0)
 {
 }
 
+void SimpleCubeViewer::setFrameSource(const std::string& spec, bool realTime) {
+    sourceSpec = spec;
+    realTimeSource = realTime;
+}
+
 SimpleCubeViewer::~SimpleCubeViewer() {
+    // A mesh update may still be writing our buffers
+    TaskScheduler::shared().wait(meshUpdate);
+    
     // Clean up texture
     if (textureID != 0) {
         glDeleteTextures(1, &textureID);
@@ -146,6 +165,7 @@ void SimpleCubeViewer::setupMesh() {
     vertices = new float[MESH_VERTICES * 3];  // x, y, z for each vertex
     texCoords = new float[MESH_VERTICES * 2]; // u, v for each vertex
     indices = new unsigned int[MESH_INDICES]; // triangle indices
+    meshDepthZ.assign(MESH_VERTICES, 0.0f);
     
     // Generate vertices, texture coordinates, and indices for 128x128 grid
     for (int y = 0; y < MESH_HEIGHT; y++) {
@@ -226,7 +246,8 @@ void SimpleCubeViewer::initializeWebcam() {
     std::cout << "Initializing webcam for 3D cube texturing..." << std::endl;
     
     // Create webcam using the factory - demonstration of easy integration!
-    webcam = WebcamFactory::create();
+    // The live camera captures on its own thread so render() never waits on it
+    webcam = WebcamFactory::createFromSpec(sourceSpec, realTimeSource);
     
     if (webcam && webcam->isActive()) {
         webcamActive = true;
@@ -243,9 +264,22 @@ void SimpleCubeViewer::initializeDepthEstimator() {
     std::cout << "Initializing depth estimator for inferno depth mapping..." << std::endl;
     
     // Create depth estimator using the factory with model path
-    depthEstimator = DepthEstimatorFactory::create("models/midasv2_small_256x256.onnx");
+    std::unique_ptr<IDepthEstimator> estimator;
+    if (depthBudgetMs > 0.0 && depthTier != DepthEstimatorFactory::TIER_LOW_POWER) {
+        std::unique_ptr<AdaptiveDepthEstimator> adaptive = DepthEstimatorFactory::createAdaptive(depthBudgetMs, autoSelectBackend);
+        depthQuality = adaptive.get();
+        estimator = std::move(adaptive);
+        if (!estimator && depthTier == DepthEstimatorFactory::TIER_AUTO) {
+            estimator = DepthEstimatorFactory::createClassical();
+        }
+    } else {
+        estimator = DepthEstimatorFactory::createForTier(depthTier, autoSelectBackend);
+    }
     
-    if (depthEstimator) {
+    if (estimator) {
+        // Reuse the previous depth while the scene is still, off the render thread
+        depthGate = new MotionGatedDepthEstimator(std::move(estimator));
+        depthEstimator = std::unique_ptr<AsyncDepthEstimator>(new AsyncDepthEstimator(std::unique_ptr<IDepthEstimator>(depthGate)));
         depthEstimatorActive = true;
         std::cout << "✅ Depth estimator initialized successfully for 3D demo!" << std::endl;
         std::cout << "🔥 Inferno depth mapping will be applied to cube faces!" << std::endl;
@@ -268,48 +302,61 @@ void SimpleCubeViewer::createTexture() {
 }
 
 void SimpleCubeViewer::updateMeshTexture() {
-    if (!webcam || !webcam->isActive() || textureID == 0) {
+    if (webcamPacket.image.empty() || textureID == 0) {
         return;
     }
     
-    // Capture frame from webcam for texture
-    if (webcam->captureFrame(webcamFrame) && !webcamFrame.empty()) {
-        // Convert BGR to RGB for OpenGL
-        cv::Mat rgbFrame;
-        cv::cvtColor(webcamFrame, rgbFrame, cv::COLOR_BGR2RGB);
-        
-        // Flip vertically for OpenGL texture coordinates
-        cv::Mat flippedFrame;
-        cv::flip(rgbFrame, flippedFrame, 0);
-        
-        // Update OpenGL texture with webcam frame
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 
-                     flippedFrame.cols, flippedFrame.rows, 0, 
-                     GL_RGB, GL_UNSIGNED_BYTE, flippedFrame.data);
-    }
+    // Flip vertically for OpenGL texture coordinates, into a buffer reused across frames.
+    // The texture takes BGR directly; raw YUV frames are converted once, in the frame context
+    // (render() attaches it), so the depth worker can reuse the conversion.
+    cv::flip(webcamPacket.context->bgr(webcamPacket), textureBuffer, 0);
+    
+    // Update OpenGL texture with webcam frame
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 
+                 textureBuffer.cols, textureBuffer.rows, 0, 
+                 GL_BGR, GL_UNSIGNED_BYTE, textureBuffer.data);
+    webcamPacket.markStage(FramePacket::STAGE_UPLOAD);
 }
 
 void SimpleCubeViewer::updateMeshGeometry() {
-    if (!depthEstimator || !depthEstimatorActive || !webcam) return;
-    
-    // Capture current frame for depth estimation
-    cv::Mat currentFrame;
-    if (!webcam->captureFrame(currentFrame) || currentFrame.empty()) return;
-    
-    cv::Mat depthMap = depthEstimator->estimateDepth(currentFrame);
-    if (depthMap.empty()) return;
+    if (!depthEstimator || !depthEstimatorActive) return;
+    
+    // Apply the displacement of a finished update; only the render thread touches the vertices
+    if (meshUpdatePending) {
+        if (!meshUpdate.isDone()) return;
+        TaskScheduler::shared().wait(meshUpdate);
+        for (int index = 0; index < MESH_VERTICES; index++) {
+            vertices[index * 3 + 2] = meshDepthZ[index];
+        }
+        meshUpdatePending = false;
+    }
     
+    // Only rebuild the mesh when inference has produced depth for a newer frame
+    DepthResult result;
+    if (!depthEstimator->getLatestResult(result)) return;
+    if (meshHasDepth && result.sequence == meshDepthSequence) return;
+    meshDepthSequence = result.sequence;
+    meshHasDepth = true;
+    
+    // Resampling the depth map runs off the render thread; the mesh shows it on a later frame
+    meshUpdatePending = true;
+    cv::Mat depthMap = result.depthMap;
+    TaskScheduler::shared().submit(TaskScheduler::PRIORITY_NORMAL, [this, depthMap]() {
+        computeMeshDepth(depthMap);
+    }, &meshUpdate);
+}
+
+void SimpleCubeViewer::computeMeshDepth(const cv::Mat& depthMap) {
     // Resize depth map to match mesh resolution
-    cv::Mat resizedDepthMap;
-    cv::resize(depthMap, resizedDepthMap, cv::Size(MESH_WIDTH, MESH_HEIGHT));
+    cv::resize(depthMap, meshDepthBuffer, cv::Size(MESH_WIDTH, MESH_HEIGHT));
     
     // Convert to single channel if needed (depth should be grayscale)
     cv::Mat grayDepth;
-    if (resizedDepthMap.channels() == 3) {
-        cv::cvtColor(resizedDepthMap, grayDepth, cv::COLOR_BGR2GRAY);
+    if (meshDepthBuffer.channels() == 3) {
+        cv::cvtColor(meshDepthBuffer, grayDepth, cv::COLOR_BGR2GRAY);
     } else {
-        grayDepth = resizedDepthMap;
+        grayDepth = meshDepthBuffer;
     }
     
     // Update vertex Z coordinates based on depth values
@@ -338,17 +385,23 @@ void SimpleCubeViewer::updateMeshGeometry() {
             }
             
             // Apply depth displacement to Z coordinate
-            vertices[index * 3 + 2] = depth * depthScale;
+            meshDepthZ[index] = depth * depthScale;
         }
     }
 }
 
 void SimpleCubeViewer::render() {
-    // Update mesh texture and geometry if both webcam and depth estimator are available
-    if (webcamActive && depthEstimatorActive) {
+    // Update the mesh texture at camera rate and hand each new frame to the depth worker;
+    // the geometry follows whenever inference finishes. With no new frame the previous mesh is redrawn.
+    if (webcamActive && depthEstimatorActive && webcam->capturePacket(webcamPacket) && !webcamPacket.image.empty()) {
+        FrameContext::attach(webcamPacket, contextPool);
         updateMeshTexture();
-        updateMeshGeometry();
+        depthEstimator->submit(webcamPacket);
+        webcamPacket.markStage(FramePacket::STAGE_PROCESS);
+        frameStats.record(webcamPacket);
+        processedFrames++;
     }
+    updateMeshGeometry();
     
     // Clear the screen and depth buffer
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -3,19 +3,53 @@
 #include <GLFW/glfw3.h>
 #include <opencv2/opencv.hpp>
 #include "IWebcamCapture.h"
-#include "IDepthEstimator.h"
+#include "AsyncDepthEstimator.h"
+#include "MotionGatedDepthEstimator.h"
+#include "AdaptiveDepthEstimator.h"
+#include "DepthEstimatorFactory.h"
+#include "FrameStats.h"
+#include "FrameContext.h"
+#include "TaskScheduler.h"
 #include <memory>
+#include <string>
+#include <cstdint>
+#include <vector>
 
 class SimpleCubeViewer {
 public:
     SimpleCubeViewer();
     ~SimpleCubeViewer();
     
+    // Choose the frame source (see WebcamFactory::createFromSpec); call before initialize()
+    void setFrameSource(const std::string& spec, bool realTime);
+    
+    // Benchmark DNN configurations when loading the depth model; call before initialize()
+    void setAutoSelectBackend(bool enabled) { autoSelectBackend = enabled; }
+    
+    // Adapt depth model and resolution to stay within this many ms per inference (0 = fixed model);
+    // call before initialize()
+    void setDepthLatencyBudget(double milliseconds) { depthBudgetMs = milliseconds; }
+    
+    // MiDaS, classical cues, or MiDaS with classical fallback (the default); call before initialize()
+    void setDepthTier(DepthEstimatorFactory::Tier tier) { depthTier = tier; }
+    
     bool initialize(GLFWwindow* window);
     void render();
     void handleMouseInput(double xpos, double ypos, bool isDragging);
     void handleResize(int width, int height);
     
+    // Number of frames that updated the mesh texture and geometry
+    uint64_t getProcessedFrameCount() const { return processedFrames; }
+    
+    // Per-stage latency and dropped-frame statistics
+    std::string getFrameStatsSummary() const { return frameStats.summary(); }
+    
+    // How often depth was reused because the scene was still
+    std::string getDepthGateSummary() const { return depthGate ? depthGate->summary() : ""; }
+    
+    // Depth quality switches made to hold the latency budget
+    std::string getDepthQualitySummary() const { return depthQuality ? depthQuality->summary() : ""; }
+    
 private:
     void setupMesh();
     void renderMesh();
@@ -25,6 +59,7 @@ private:
     void updateMeshTexture();
     void createTexture();
     void updateMeshGeometry();
+    void computeMeshDepth(const cv::Mat& depthMap);
     
     // Mesh properties
     static const int MESH_WIDTH = 128;
@@ -55,10 +90,31 @@ private:
     
     // Webcam and texture
     std::unique_ptr<IWebcamCapture> webcam;
-    std::unique_ptr<IDepthEstimator> depthEstimator;
-    cv::Mat webcamFrame;
+    std::unique_ptr<AsyncDepthEstimator> depthEstimator;  // Inference runs off the render thread
+    MotionGatedDepthEstimator* depthGate;                  // Owned by depthEstimator
+    AdaptiveDepthEstimator* depthQuality;                  // Owned by depthEstimator; null without a budget
+    FramePacket webcamPacket; // Current frame with capture timestamp and sequence number
+    std::vector<std::shared_ptr<FrameContext>> contextPool;  // Derived images shared with the depth worker
+    FrameStats frameStats;
     cv::Mat depthFrame;
+    cv::Mat textureBuffer;    // Reused texture upload buffer
+    cv::Mat meshDepthBuffer;  // Reused depth map resized to mesh resolution
+    uint64_t meshDepthSequence;  // Frame whose depth the mesh currently shows
+    bool meshHasDepth;
+    
+    // Vertex displacement is computed by a scheduler task and copied into the mesh once done
+    TaskScheduler::TaskGroup meshUpdate;
+    std::vector<float> meshDepthZ;
+    bool meshUpdatePending;
     GLuint textureID;
     bool webcamActive;
     bool depthEstimatorActive;
+    
+    // Frame source selection
+    std::string sourceSpec;
+    bool realTimeSource;
+    bool autoSelectBackend;
+    double depthBudgetMs;
+    DepthEstimatorFactory::Tier depthTier;
+    uint64_t processedFrames;
 };
@@ -0,0 +1,152 @@
+#include "StageGraph.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+const char* const StageGraph::kFrameInput = "frame";
+
+namespace {
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+StageGraph::StageGraph()
+    : frameCount(0)
+    , frameMs(0.0) {
+}
+
+bool StageGraph::addStage(const std::string& name, const std::vector<std::string>& inputs,
+                          const std::vector<std::string>& outputs, StageFunction function,
+                          TaskScheduler::Priority priority) {
+    if (findStage(name) >= 0) {
+        std::cerr << "❌ Error: Stage '" << name << "' is already registered" << std::endl;
+        return false;
+    }
+    
+    // Each input is the frame or an output of an earlier stage; the stage goes one level below
+    // the deepest stage it reads from
+    int level = 0;
+    for (const std::string& input : inputs) {
+        if (input == kFrameInput) {
+            continue;
+        }
+        int producer = -1;
+        for (size_t i = 0; i < stages.size() && producer < 0; i++) {
+            if (std::find(stages[i].outputs.begin(), stages[i].outputs.end(), input) != stages[i].outputs.end()) {
+                producer = static_cast<int>(i);
+            }
+        }
+        if (producer < 0) {
+            std::cerr << "❌ Error: Stage '" << name << "' reads '" << input << "', which no earlier stage writes" << std::endl;
+            return false;
+        }
+        level = std::max(level, stages[producer].level + 1);
+    }
+    for (const std::string& output : outputs) {
+        for (const Stage& stage : stages) {
+            if (output == kFrameInput || std::find(stage.outputs.begin(), stage.outputs.end(), output) != stage.outputs.end()) {
+                std::cerr << "❌ Error: Stage '" << name << "' writes '" << output << "', which already has a producer" << std::endl;
+                return false;
+            }
+        }
+    }
+    
+    Stage stage;
+    stage.name = name;
+    stage.inputs = inputs;
+    stage.outputs = outputs;
+    stage.function = function;
+    stage.priority = priority;
+    stage.enabled = true;
+    stage.level = level;
+    stage.runs = 0;
+    stage.totalMs = 0.0;
+    stages.push_back(stage);
+    
+    if (static_cast<size_t>(level) >= levels.size()) {
+        levels.resize(level + 1);
+    }
+    levels[level].push_back(stages.size() - 1);
+    return true;
+}
+
+int StageGraph::findStage(const std::string& name) const {
+    for (size_t i = 0; i < stages.size(); i++) {
+        if (stages[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void StageGraph::setEnabled(const std::string& name, bool enabled) {
+    int index = findStage(name);
+    if (index >= 0) {
+        stages[index].enabled = enabled;
+    }
+}
+
+bool StageGraph::isEnabled(const std::string& name) const {
+    int index = findStage(name);
+    return index >= 0 && stages[index].enabled;
+}
+
+void StageGraph::run(FramePacket& packet) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    TaskScheduler& scheduler = TaskScheduler::shared();
+    
+    std::vector<size_t> ready;
+    for (const std::vector<size_t>& level : levels) {
+        ready.clear();
+        for (size_t index : level) {
+            if (stages[index].enabled) {
+                ready.push_back(index);
+            }
+        }
+        if (ready.empty()) {
+            continue;
+        }
+        
+        // Hand all but the first stage to the scheduler and run the first one here
+        TaskScheduler::TaskGroup others;
+        for (size_t i = 1; i < ready.size(); i++) {
+            Stage& stage = stages[ready[i]];
+            scheduler.submit(stage.priority, [this, &stage, &packet]() { runStage(stage, packet); }, &others);
+        }
+        runStage(stages[ready[0]], packet);
+        scheduler.wait(others);
+    }
+    
+    frameCount++;
+    frameMs += millisecondsSince(start);
+}
+
+void StageGraph::runStage(Stage& stage, FramePacket& packet) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    try {
+        stage.function(packet);
+    } catch (const cv::Exception& e) {
+        std::cerr << "❌ Error in stage '" << stage.name << "': " << e.what() << std::endl;
+    }
+    stage.totalMs += millisecondsSince(start);
+    stage.runs++;
+}
+
+std::string StageGraph::summary() const {
+    std::ostringstream out;
+    double serialMs = 0.0;
+    out << "Stages:";
+    for (size_t i = 0; i < stages.size(); i++) {
+        const Stage& stage = stages[i];
+        const double meanMs = stage.runs ? stage.totalMs / stage.runs : 0.0;
+        out << (i > 0 ? "," : "") << " " << stage.name << " " << meanMs << " ms";
+        serialMs += frameCount ? stage.totalMs / frameCount : 0.0;
+    }
+    out << "; frame " << (frameCount ? frameMs / frameCount : 0.0) << " ms (" << serialMs << " ms run one after another)";
+    return out.str();
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "FramePacket.h"
+#include "TaskScheduler.h"
+
+/**
+ * Runs a frame through a set of stages in dependency order, running stages that don't
+ * depend on each other at the same time.
+ * Each stage declares the named products it reads and writes. The products themselves
+ * live with whoever registered the stage; the graph only uses the names to order the work.
+ * A stage may only read "frame" (the packet) and products of stages registered before
+ * it, so registration order is always a valid order and cycles can't be built.
+ * Stages are grouped into levels by their longest chain of inputs, and the stages of a
+ * level run concurrently: one on the calling thread, the rest as tasks of the shared
+ * TaskScheduler at the priority each stage was registered with. A frame therefore takes
+ * about as long as the slowest stage of each level rather than the sum of all stages.
+ * Several graphs (one per stream, say) share the scheduler's workers rather than each
+ * keeping threads of its own.
+ * A disabled stage is skipped and its products are simply not updated; stages reading
+ * them must cope with that. Per-stage and per-frame times are accumulated for summary().
+ */
+class StageGraph {
+public:
+    typedef std::function<void(FramePacket& packet)> StageFunction;
+    
+    // The input every graph has: the frame being processed
+    static const char* const kFrameInput;
+    
+    StageGraph();
+    
+    /**
+     * Register a stage. Call before the first run().
+     * @param inputs "frame" and/or outputs of stages already registered
+     * @param outputs Names of the products the stage writes; each name has one producer
+     * @param priority Scheduler priority of the stage when it runs beside others
+     * @return false if the name is taken, an input has no producer or an output already has one
+     */
+    bool addStage(const std::string& name, const std::vector<std::string>& inputs,
+                  const std::vector<std::string>& outputs, StageFunction function,
+                  TaskScheduler::Priority priority = TaskScheduler::PRIORITY_NORMAL);
+    
+    void setEnabled(const std::string& name, bool enabled);
+    bool isEnabled(const std::string& name) const;
+    
+    // Run every enabled stage on `packet`, level by level
+    void run(FramePacket& packet);
+    
+    // Mean time of each stage, of whole frames, and the serial sum the levels save on
+    std::string summary() const;
+
+private:
+    struct Stage {
+        std::string name;
+        std::vector<std::string> inputs;
+        std::vector<std::string> outputs;
+        StageFunction function;
+        TaskScheduler::Priority priority;
+        bool enabled;
+        int level;        // 0 for stages that only read the frame
+        uint64_t runs;
+        double totalMs;
+    };
+    
+    std::vector<Stage> stages;
+    std::vector<std::vector<size_t>> levels;  // Stage indices per level
+    
+    uint64_t frameCount;
+    double frameMs;
+    
+    int findStage(const std::string& name) const;
+    void runStage(Stage& stage, FramePacket& packet);
+    
+    StageGraph(const StageGraph&) = delete;
+    StageGraph& operator=(const StageGraph&) = delete;
+};
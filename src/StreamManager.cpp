@@ -0,0 +1,181 @@
+#include "StreamManager.h"
+#include "FrameProcessor.h"
+#include "FrameContext.h"
+#include "CoreBudget.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+StreamManager::StreamManager()
+    : running(false)
+    , depthPool(nullptr)
+    , edgeDetectionEnabled(false)
+    , faceDetectionEnabled(false)
+    , depthEstimationEnabled(false)
+    , depthBatchSize(1) {
+}
+
+StreamManager::~StreamManager() {
+    stop();
+}
+
+int StreamManager::addStream(std::unique_ptr<IWebcamCapture> source, const std::string& name) {
+    int sourceId = static_cast<int>(streams.size());
+    source->setSourceId(sourceId);
+    
+    std::unique_ptr<Stream> stream(new Stream());
+    stream->source = std::move(source);
+    stream->name = name;
+    stream->busy = false;
+    stream->frames = 0;
+    stream->dropped = 0;
+    stream->lastSequence = 0;
+    stream->seenAny = false;
+    streams.push_back(std::move(stream));
+    return sourceId;
+}
+
+bool StreamManager::start(size_t workerCount, DepthEstimatorPool* pool) {
+    if (running || streams.empty()) {
+        return false;
+    }
+    
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    depthPool = pool;
+    startTime = std::chrono::steady_clock::now();
+    running = true;
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.push_back(std::thread(&StreamManager::workerLoop, this, i));
+    }
+    
+    std::cout << "🚀 Processing " << streams.size() << " stream(s) on " << workerCount << " worker(s)";
+    if (depthPool && depthEstimationEnabled) {
+        std::cout << " sharing " << depthPool->size() << " depth estimator(s)";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+void StreamManager::stop() {
+    running = false;
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers.clear();
+}
+
+void StreamManager::workerLoop(size_t workerIndex) {
+    // Workers capture, process and run depth, so they all go on the inference cores
+    CoreBudget::ThreadScope threadScope(CoreBudget::ROLE_INFERENCE, "worker " + std::to_string(workerIndex));
+    
+    // Each worker has its own processor: cascades and scratch buffers aren't shareable
+    FrameProcessor processor;
+    processor.setVerbose(false);
+    processor.setEdgeDetection(edgeDetectionEnabled);
+    processor.setDepthEstimation(depthEstimationEnabled && depthPool != nullptr);
+    if (faceDetectionEnabled) {
+        processor.setFaceDetection(processor.loadFaceCascade());
+    }
+    
+    const size_t streamCount = streams.size();
+    const size_t batchLimit = processor.isDepthEstimationEnabled() ? std::min(depthBatchSize, streamCount) : 1;
+    std::vector<Stream*> claimed;
+    std::vector<FramePacket> batch;
+    std::vector<cv::Mat> depthMaps;
+    std::vector<std::shared_ptr<FrameContext>> contextPool;
+    size_t next = workerIndex % streamCount;  // Stagger starting points across workers
+    
+    while (running) {
+        // Gather up to batchLimit frames, one per stream. A claimed stream is processed by
+        // this worker only, so its frames stay in order.
+        claimed.clear();
+        batch.resize(batchLimit);
+        for (size_t i = 0; i < streamCount && claimed.size() < batchLimit && running; i++) {
+            Stream& stream = *streams[(next + i) % streamCount];
+            
+            bool expected = false;
+            if (!stream.busy.compare_exchange_strong(expected, true)) {
+                continue;
+            }
+            
+            FramePacket& packet = batch[claimed.size()];
+            if (stream.source->capturePacket(packet) && !packet.image.empty()) {
+                if (stream.seenAny && packet.sequence > stream.lastSequence + 1) {
+                    stream.dropped += packet.sequence - stream.lastSequence - 1;
+                }
+                stream.lastSequence = packet.sequence;
+                stream.seenAny = true;
+                FrameContext::attach(packet, contextPool);
+                claimed.push_back(&stream);
+            } else {
+                stream.busy = false;
+            }
+        }
+        next = (next + 1) % streamCount;
+        
+        // Nothing was ready anywhere: yield instead of spinning on the capture mailboxes
+        if (claimed.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        batch.resize(claimed.size());
+        
+        // One depth pass for the whole batch. Heat map rendering doesn't use inference
+        // state, so the estimator goes back to the pool before compositing.
+        IDepthEstimator* heatMapper = nullptr;
+        depthMaps.assign(batch.size(), cv::Mat());
+        if (processor.isDepthEstimationEnabled()) {
+            DepthEstimatorPool::Lease estimator = depthPool->acquire();
+            if (estimator) {
+                depthMaps = estimator->estimateDepthBatch(batch);
+                heatMapper = estimator.get();
+            }
+        }
+        
+        for (size_t i = 0; i < claimed.size(); i++) {
+            processor.process(batch[i], depthMaps[i].empty() ? nullptr : heatMapper, depthMaps[i]);
+            batch[i].image.release();  // Hand the buffer back to the source's pool
+            batch[i].context.reset();
+            claimed[i]->frames++;
+            claimed[i]->busy = false;
+        }
+    }
+}
+
+std::vector<StreamManager::StreamStats> StreamManager::getStats() const {
+    double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    
+    std::vector<StreamStats> stats;
+    for (const std::unique_ptr<Stream>& stream : streams) {
+        StreamStats s;
+        s.sourceId = stream->source->getSourceId();
+        s.name = stream->name;
+        s.frames = stream->frames;
+        s.dropped = stream->dropped;
+        s.fps = elapsedSeconds > 0 ? s.frames / elapsedSeconds : 0.0;
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+std::string StreamManager::statsSummary() const {
+    std::vector<StreamStats> stats = getStats();
+    
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    double totalFps = 0.0;
+    uint64_t totalFrames = 0;
+    for (const StreamStats& s : stats) {
+        out << "  [" << s.sourceId << "] " << s.name << ": " << s.fps << " FPS, "
+            << s.frames << " frames, " << s.dropped << " dropped\n";
+        totalFps += s.fps;
+        totalFrames += s.frames;
+    }
+    out << "  Aggregate: " << totalFps << " FPS over " << stats.size() << " stream(s), " << totalFrames << " frames";
+    return out.str();
+}
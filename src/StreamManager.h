@@ -0,0 +1,96 @@
+#pragma once
+
+#include "IWebcamCapture.h"
+#include "DepthEstimatorPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Runs edge, face and depth processing on several frame sources at once.
+ * A fixed set of worker threads shares all streams: each worker claims whichever
+ * stream has a frame ready, processes it with its own FrameProcessor and borrows a
+ * depth estimator from a shared pool, so throughput scales with the number of cores
+ * rather than the number of processes, and the network is loaded only once per pool slot.
+ * With a depth batch size above 1, a worker gathers frames from several streams and
+ * estimates their depth in a single batched forward pass.
+ * The workers are long-running claim loops and keep their own threads; the stages of
+ * each worker's processor run on the shared TaskScheduler, so adding streams doesn't add
+ * stage threads.
+ */
+class StreamManager {
+public:
+    // Point-in-time counters for one stream
+    struct StreamStats {
+        int sourceId;
+        std::string name;
+        uint64_t frames;
+        uint64_t dropped;   // Sequence gaps seen by the workers
+        double fps;         // Average since start()
+    };
+    
+    StreamManager();
+    ~StreamManager();
+    
+    /**
+     * Add a frame source. Must be called before start(). The manager takes ownership
+     * and assigns the source ID used in its packets.
+     * @return The stream's source ID
+     */
+    int addStream(std::unique_ptr<IWebcamCapture> source, const std::string& name);
+    
+    // Processing options applied to every stream (call before start())
+    void setEdgeDetection(bool enabled) { edgeDetectionEnabled = enabled; }
+    void setFaceDetection(bool enabled) { faceDetectionEnabled = enabled; }
+    void setDepthEstimation(bool enabled) { depthEstimationEnabled = enabled; }
+    
+    // Most frames a worker gathers from different streams for one batched depth pass (default 1)
+    void setDepthBatchSize(size_t size) { depthBatchSize = std::max<size_t>(1, size); }
+    
+    /**
+     * Start the workers.
+     * @param workerCount Number of processing threads (0 = one per hardware thread)
+     * @param depthPool Shared depth estimators, or nullptr to skip depth
+     */
+    bool start(size_t workerCount, DepthEstimatorPool* depthPool);
+    
+    // Stop and join the workers
+    void stop();
+    
+    bool isRunning() const { return running; }
+    size_t getStreamCount() const { return streams.size(); }
+    
+    std::vector<StreamStats> getStats() const;
+    
+    // Per-stream and aggregate frame rates
+    std::string statsSummary() const;
+    
+private:
+    struct Stream {
+        std::unique_ptr<IWebcamCapture> source;
+        std::string name;
+        std::atomic<bool> busy;          // Claimed by a worker
+        std::atomic<uint64_t> frames;
+        std::atomic<uint64_t> dropped;
+        uint64_t lastSequence;           // Only touched by the worker holding the claim
+        bool seenAny;
+    };
+    
+    std::vector<std::unique_ptr<Stream>> streams;
+    std::vector<std::thread> workers;
+    std::atomic<bool> running;
+    DepthEstimatorPool* depthPool;
+    std::chrono::steady_clock::time_point startTime;
+    
+    bool edgeDetectionEnabled;
+    bool faceDetectionEnabled;
+    bool depthEstimationEnabled;
+    size_t depthBatchSize;
+    
+    void workerLoop(size_t workerIndex);
+};
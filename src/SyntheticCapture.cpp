@@ -0,0 +1,86 @@
+#include "SyntheticCapture.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+SyntheticCapture::SyntheticCapture(int width, int height, double fps, bool realTime)
+    : frameSize(width, height), pacer(fps, realTime), frameIndex(0), active(false) {
+}
+
+SyntheticCapture::~SyntheticCapture() {
+    release();
+}
+
+bool SyntheticCapture::initialize() {
+    if (frameSize.width <= 0 || frameSize.height <= 0) {
+        std::cerr << "❌ Error: Invalid synthetic frame size " << frameSize.width << "x" << frameSize.height << std::endl;
+        return false;
+    }
+    
+    frameIndex = 0;
+    pacer.reset();
+    
+    std::cout << "✅ Synthetic source: " << frameSize.width << "x" << frameSize.height
+              << " @ " << pacer.getFrameRate() << " FPS"
+              << (pacer.isRealTime() ? " (real-time)" : " (as fast as possible)") << std::endl;
+    active = true;
+    return true;
+}
+
+bool SyntheticCapture::capturePacket(FramePacket& packet) {
+    if (!active) {
+        return false;
+    }
+    
+    pacer.waitForNextFrame();
+    packet.image = framePool.acquire(frameSize, CV_8UC3);
+    renderPattern(frameIndex++, packet.image);
+    stampPacket(packet);
+    return true;
+}
+
+void SyntheticCapture::release() {
+    framePool.clear();
+    active = false;
+}
+
+void SyntheticCapture::renderPattern(uint64_t index, cv::Mat& frame) const {
+    frame.create(frameSize, CV_8UC3);  // No-op for pooled buffers of the right size
+    
+    const int width = frameSize.width;
+    const int height = frameSize.height;
+    const int shift = static_cast<int>(index % 256);
+    
+    // Scrolling diagonal gradient with a vertical brightness falloff as a depth cue
+    for (int y = 0; y < height; y++) {
+        cv::Vec3b* row = frame.ptr<cv::Vec3b>(y);
+        const int shade = 64 + (191 * y) / height;
+        for (int x = 0; x < width; x++) {
+            const int t = (x + y + shift) & 0xFF;
+            row[x] = cv::Vec3b(static_cast<uchar>((t * shade) >> 8),
+                               static_cast<uchar>(((255 - t) * shade) >> 8),
+                               static_cast<uchar>(shade));
+        }
+    }
+    
+    // Checkerboard band across the top for edge detection
+    const int cell = std::max(8, width / 32);
+    for (int y = 0; y < height / 6; y++) {
+        cv::Vec3b* row = frame.ptr<cv::Vec3b>(y);
+        for (int x = 0; x < width; x++) {
+            if ((((x + shift) / cell) + (y / cell)) % 2 == 0) {
+                row[x] = cv::Vec3b(240, 240, 240);
+            }
+        }
+    }
+    
+    // A disc moving on a Lissajous path stands in for a foreground subject
+    const double phase = static_cast<double>(index) / 60.0;
+    cv::Point center(static_cast<int>(width * (0.5 + 0.3 * std::sin(phase * 2.0 * CV_PI))),
+                     static_cast<int>(height * (0.55 + 0.2 * std::sin(phase * 3.0 * CV_PI))));
+    cv::circle(frame, center, std::min(width, height) / 6, cv::Scalar(40, 180, 255), cv::FILLED);
+    
+    std::string label = "frame " + std::to_string(static_cast<unsigned long long>(index));
+    cv::putText(frame, label, cv::Point(10, height - 10), cv::FONT_HERSHEY_SIMPLEX, 0.6, cv::Scalar(255, 255, 255), 1);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include "IWebcamCapture.h"
+#include "FramePacer.h"
+#include "FramePool.h"
+
+/**
+ * Generates a deterministic moving test pattern through the webcam interface.
+ * Frame N is always identical across runs, so benchmarks need no hardware or media files.
+ */
+class SyntheticCapture : public IWebcamCapture {
+public:
+    SyntheticCapture(int width = 640, int height = 480, double fps = 30.0, bool realTime = true);
+    ~SyntheticCapture() override;
+    
+    // Start generating frames
+    bool initialize() override;
+    
+    // Render the next frame of the pattern
+    bool capturePacket(FramePacket& packet) override;
+    
+    // Check if the generator is running
+    bool isActive() const override { return active; }
+    
+    // Stop generating frames
+    void release() override;
+    
+    // Get frame dimensions
+    cv::Size getFrameSize() const override { return frameSize; }
+    
+    // Frame buffers allocated by the pattern pool
+    uint64_t getBufferAllocationCount() const override { return framePool.getAllocationCount(); }
+    void reserveFrameBuffers(size_t frames) override { framePool.reserve(frames); }
+    
+private:
+    cv::Size frameSize;
+    FramePacer pacer;
+    FramePool framePool;
+    uint64_t frameIndex;
+    bool active;
+    
+    // Draw pattern frame number `index` into `frame`
+    void renderPattern(uint64_t index, cv::Mat& frame) const;
+};
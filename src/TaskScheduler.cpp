@@ -0,0 +1,231 @@
+#include "TaskScheduler.h"
+#include "CoreBudget.h"
+#include <algorithm>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+const char* const kPriorityNames[TaskScheduler::PRIORITY_COUNT] = {"high", "normal", "low"};
+
+// The scheduler and worker index of the calling thread, if it is a worker
+thread_local TaskScheduler* currentScheduler = nullptr;
+thread_local int currentWorker = -1;
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+size_t TaskScheduler::requestedWorkers = 0;
+
+void TaskScheduler::setWorkerCount(size_t count) {
+    requestedWorkers = count;
+}
+
+TaskScheduler& TaskScheduler::shared() {
+    // Never destroyed: objects with static lifetime may still wait on it while the process exits
+    static TaskScheduler* scheduler = new TaskScheduler(
+        requestedWorkers > 0 ? requestedWorkers : CoreBudget::getCpuCount(CoreBudget::ROLE_INFERENCE));
+    return *scheduler;
+}
+
+TaskScheduler::TaskScheduler(size_t workerCount)
+    : queued(0)
+    , nextWorker(0)
+    , stopping(false)
+    , stealCount(0)
+    , startTime(std::chrono::steady_clock::now()) {
+    for (int priority = 0; priority < PRIORITY_COUNT; priority++) {
+        executedCount[priority] = 0;
+    }
+    
+    // All workers exist before any starts, since each may steal from all the others
+    workerCount = std::max<size_t>(1, workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        std::unique_ptr<Worker> worker(new Worker());
+        worker->idleMs = 0.0;
+        worker->sleeping = false;
+        workers.push_back(std::move(worker));
+    }
+    for (size_t i = 0; i < workerCount; i++) {
+        workers[i]->thread = std::thread(&TaskScheduler::workerLoop, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::unique_ptr<Worker>& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+void TaskScheduler::submit(Priority priority, Task task, TaskGroup* group) {
+    Entry entry;
+    entry.task = std::move(task);
+    entry.group = group;
+    entry.priority = priority;
+    if (group) {
+        group->pending++;
+    }
+    
+    // A worker keeps its own tasks; everyone else's are dealt out in turn
+    const size_t target = currentScheduler == this ? static_cast<size_t>(currentWorker) : nextWorker++ % workers.size();
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mutex);
+        workers[target]->queues[priority].push_back(std::move(entry));
+    }
+    queued++;
+    
+    // Taking the lock orders this against a worker checking `queued` before it sleeps
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    workAvailable.notify_one();
+}
+
+bool TaskScheduler::takeTask(int self, const TaskGroup* only, Entry& entry) {
+    const size_t count = workers.size();
+    const size_t first = self >= 0 ? static_cast<size_t>(self) : 0;
+    
+    for (int priority = 0; priority < PRIORITY_COUNT; priority++) {
+        for (size_t k = 0; k < count; k++) {
+            const size_t victim = (first + k) % count;
+            const bool own = static_cast<int>(victim) == self;
+            std::lock_guard<std::mutex> lock(workers[victim]->mutex);
+            std::deque<Entry>& queue = workers[victim]->queues[priority];
+            if (queue.empty()) {
+                continue;
+            }
+            
+            // Own work newest first, stolen work oldest first
+            std::deque<Entry>::iterator found = queue.end();
+            if (!only) {
+                found = own ? queue.end() - 1 : queue.begin();
+            } else if (own) {
+                for (std::deque<Entry>::iterator it = queue.end(); it != queue.begin();) {
+                    if ((--it)->group == only) {
+                        found = it;
+                        break;
+                    }
+                }
+            } else {
+                for (std::deque<Entry>::iterator it = queue.begin(); it != queue.end() && found == queue.end(); ++it) {
+                    if (it->group == only) {
+                        found = it;
+                    }
+                }
+            }
+            if (found == queue.end()) {
+                continue;
+            }
+            
+            entry = std::move(*found);
+            queue.erase(found);
+            queued--;
+            if (!own && self >= 0) {
+                stealCount++;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::runTask(Entry& entry) {
+    try {
+        entry.task();
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Error in scheduled task: " << e.what() << std::endl;
+    }
+    entry.task = Task();
+    executedCount[entry.priority]++;
+    
+    if (entry.group) {
+        // Under the group's lock, so a waiter can't return and destroy it mid-notify
+        std::lock_guard<std::mutex> lock(entry.group->mutex);
+        if (--entry.group->pending == 0) {
+            entry.group->done.notify_all();
+        }
+    }
+}
+
+void TaskScheduler::wait(TaskGroup& group) {
+    const int self = currentScheduler == this ? currentWorker : -1;
+    Entry entry;
+    while (group.pending > 0) {
+        if (takeTask(self, &group, entry)) {
+            runTask(entry);
+            continue;
+        }
+        
+        // The rest is running elsewhere; check back now and then in case a task of the group adds another
+        std::unique_lock<std::mutex> lock(group.mutex);
+        group.done.wait_for(lock, std::chrono::milliseconds(1), [&group]() { return group.pending == 0; });
+    }
+    
+    // The last task may still be notifying under the lock
+    std::lock_guard<std::mutex> lock(group.mutex);
+}
+
+void TaskScheduler::parallelFor(int count, Priority priority, const std::function<void(int)>& body) {
+    TaskGroup group;
+    for (int i = 0; i < count; i++) {
+        submit(priority, [&body, i]() { body(i); }, &group);
+    }
+    wait(group);
+}
+
+void TaskScheduler::workerLoop(size_t index) {
+    CoreBudget::ThreadScope threadScope(CoreBudget::ROLE_INFERENCE, "task worker " + std::to_string(index));
+    currentScheduler = this;
+    currentWorker = static_cast<int>(index);
+    
+    Worker& worker = *workers[index];
+    Entry entry;
+    while (true) {
+        if (takeTask(static_cast<int>(index), nullptr, entry)) {
+            runTask(entry);
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        if (stopping) {
+            return;
+        }
+        worker.sleeping = true;
+        worker.sleepStart = std::chrono::steady_clock::now();
+        workAvailable.wait(lock, [this]() { return stopping || queued > 0; });
+        worker.sleeping = false;
+        worker.idleMs += millisecondsSince(worker.sleepStart);
+    }
+}
+
+std::string TaskScheduler::summary() const {
+    uint64_t total = 0;
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << "Scheduler: " << workers.size() << " worker(s), tasks";
+    for (int priority = 0; priority < PRIORITY_COUNT; priority++) {
+        out << (priority > 0 ? "," : "") << " " << kPriorityNames[priority] << " " << executedCount[priority];
+        total += executedCount[priority];
+    }
+    
+    double idleMs = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        for (const std::unique_ptr<Worker>& worker : workers) {
+            idleMs += worker->idleMs + (worker->sleeping ? millisecondsSince(worker->sleepStart) : 0.0);
+        }
+    }
+    const double availableMs = millisecondsSince(startTime) * workers.size();
+    out << "; " << (total ? 100.0 * stealCount / total : 0.0) << "% stolen, workers idle "
+        << (availableMs > 0 ? 100.0 * idleMs / availableMs : 0.0) << "% of the time";
+    return out.str();
+}
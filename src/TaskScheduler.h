@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * One pool of worker threads for all the short-lived processing work of the process:
+ * depth inference, stage graph levels, edge tiles, overlay rows and mesh updates all
+ * submit tasks here instead of starting threads of their own. The number of threads doing
+ * that work is therefore fixed, however many frame processors or streams are running, and
+ * CPU use stays predictable when several pipelines share a machine.
+ * Each worker owns a deque per priority. A worker pushes the tasks it submits onto its own
+ * deques and runs them newest first, while they are still in cache; tasks submitted from
+ * other threads are dealt round-robin. A worker whose deques are empty steals the oldest
+ * task from another worker. A task of a higher priority is always taken, stolen if need
+ * be, before any task of a lower one, so depth inference is never stuck behind the
+ * cosmetic overlay.
+ * Long-running loops that block on devices or queues (capture, pipeline steps, stream
+ * workers) keep their own threads: a task should finish, or it holds a worker hostage.
+ * Workers are inference threads for the core budget.
+ */
+class TaskScheduler {
+public:
+    // Highest first. Inference is HIGH, per-frame effects NORMAL, cosmetic drawing LOW.
+    enum Priority { PRIORITY_HIGH, PRIORITY_NORMAL, PRIORITY_LOW, PRIORITY_COUNT };
+    
+    typedef std::function<void()> Task;
+    
+    /**
+     * A set of tasks that can be waited for together. Must outlive its tasks; wait() for
+     * them before destroying it.
+     */
+    class TaskGroup {
+    public:
+        TaskGroup() : pending(0) {}
+        
+        // Every task submitted so far has finished
+        bool isDone() const { return pending == 0; }
+    
+    private:
+        friend class TaskScheduler;
+        std::atomic<size_t> pending;
+        std::mutex mutex;
+        std::condition_variable done;
+        
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+    };
+    
+    /**
+     * Number of workers of the shared scheduler (0 = one per inference CPU of the core
+     * budget, or per hardware thread without one). Call at startup, after the core budget
+     * is configured and before anything uses shared().
+     */
+    static void setWorkerCount(size_t count);
+    
+    // The process-wide scheduler, started on first use
+    static TaskScheduler& shared();
+    
+    explicit TaskScheduler(size_t workerCount);
+    ~TaskScheduler();
+    
+    // Queue `task`; if `group` is given, wait(group) covers it
+    void submit(Priority priority, Task task, TaskGroup* group = nullptr);
+    
+    /**
+     * Wait for every task of `group`. The waiting thread runs queued tasks of the group
+     * itself rather than idling, so waiting from inside a task can't deadlock the pool,
+     * and it never picks up unrelated work that could delay it.
+     */
+    void wait(TaskGroup& group);
+    
+    // Run body(0) .. body(count - 1) as tasks and wait for all of them
+    void parallelFor(int count, Priority priority, const std::function<void(int)>& body);
+    
+    size_t getWorkerCount() const { return workers.size(); }
+    uint64_t getExecutedCount(Priority priority) const { return executedCount[priority]; }
+    uint64_t getStealCount() const { return stealCount; }
+    
+    // Tasks run per priority, share of them stolen, and how much of the time workers sat idle
+    std::string summary() const;
+
+private:
+    struct Entry {
+        Task task;
+        TaskGroup* group;
+        Priority priority;
+    };
+    
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Entry> queues[PRIORITY_COUNT];
+        std::thread thread;
+        
+        // Guarded by the scheduler's sleepMutex
+        double idleMs;
+        bool sleeping;
+        std::chrono::steady_clock::time_point sleepStart;
+    };
+    
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> queued;       // Submitted and not yet taken
+    std::atomic<size_t> nextWorker;   // Round-robin target for submissions from outside
+    
+    mutable std::mutex sleepMutex;
+    std::condition_variable workAvailable;
+    bool stopping;
+    
+    std::atomic<uint64_t> executedCount[PRIORITY_COUNT];
+    std::atomic<uint64_t> stealCount;
+    std::chrono::steady_clock::time_point startTime;
+    
+    static size_t requestedWorkers;
+    
+    /**
+     * Take the highest-priority task available to `self` (-1 for a thread outside the pool):
+     * its own newest first, then other workers' oldest. With `only`, take tasks of that group only.
+     */
+    bool takeTask(int self, const TaskGroup* only, Entry& entry);
+    void runTask(Entry& entry);
+    void workerLoop(size_t index);
+    
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+};
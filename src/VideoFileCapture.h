@@ -0,0 +1,45 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include "IWebcamCapture.h"
+#include "FramePacer.h"
+#include "FramePool.h"
+
+/**
+ * Replays a video file through the webcam interface.
+ * Useful for reproducible benchmarks on machines without a camera.
+ */
+class VideoFileCapture : public IWebcamCapture {
+public:
+    VideoFileCapture(const std::string& path, bool realTime = true, bool loop = true);
+    ~VideoFileCapture() override;
+    
+    // Open the video file
+    bool initialize() override;
+    
+    // Read the next frame (paced to the file's frame rate in real-time mode)
+    bool capturePacket(FramePacket& packet) override;
+    
+    // Check if the file is open
+    bool isActive() const override { return active; }
+    
+    // Close the video file
+    void release() override;
+    
+    // Get frame dimensions
+    cv::Size getFrameSize() const override { return frameSize; }
+    
+    // Frame buffers allocated by the decode pool
+    uint64_t getBufferAllocationCount() const override { return framePool.getAllocationCount(); }
+    void reserveFrameBuffers(size_t frames) override { framePool.reserve(frames); }
+    
+private:
+    std::string path;
+    cv::VideoCapture cap;
+    FramePacer pacer;
+    FramePool framePool;
+    cv::Size frameSize;
+    bool loop;
+    bool active;
+};
@@ -1,6 +1,13 @@
 #include "WebcamCapture.h"
+#include "CoreBudget.h"
+#include <chrono>
 
-WebcamCapture::WebcamCapture() : active(false), preferredWidth(640), preferredHeight(480) {
+WebcamCapture::WebcamCapture()
+    : active(false), preferredWidth(640), preferredHeight(480)
+    , framePool(6), latestFrameType(CV_8UC3)
+    , rawYUV(false), pixelFormat(FramePacket::PIXEL_BGR)
+    , threaded(false), capturing(false), hasNewFrame(false), droppedFrames(0)
+    , probeCachePath("camera_probe_cache"), probeTimeoutMs(3000), startupTimeMs(0.0) {
 }
 
 WebcamCapture::~WebcamCapture() {
@@ -9,67 +16,261 @@ WebcamCapture::~WebcamCapture() {
 
 bool WebcamCapture::initialize() {
     std::cout << "Attempting to open camera..." << std::endl;
-    return tryInitializeCamera();
+    if (!tryInitializeCamera()) {
+        return false;
+    }
+    
+    if (threaded) {
+        startCaptureThread();
+    }
+    return true;
 }
 
 bool WebcamCapture::tryInitializeCamera() {
-    // Try different camera backends and indices
-    std::vector<int> backends = {cv::CAP_AVFOUNDATION, cv::CAP_ANY};
-    std::vector<int> indices = {0, 1, 2};
-    
-    for (int backend : backends) {
-        for (int index : indices) {
-            std::cout << "Trying camera index " << index << " with backend " << backend << std::endl;
-            cap.open(index, backend);
-            
-            if (cap.isOpened()) {
-                std::cout << "Camera opened successfully with index " << index << " and backend " << backend << std::endl;
-                
-                // Set camera properties
-                cap.set(cv::CAP_PROP_FRAME_WIDTH, preferredWidth);
-                cap.set(cv::CAP_PROP_FRAME_HEIGHT, preferredHeight);
-                
-                // Test if we can actually read a frame
-                cv::Mat testFrame;
-                if (cap.read(testFrame) && !testFrame.empty()) {
-                    std::cout << "✅ Webcam initialized successfully!" << std::endl;
-                    std::cout << "Frame size: " << testFrame.cols << "x" << testFrame.rows << std::endl;
-                    active = true;
-                    return true;
-                } else {
-                    std::cout << "Camera opened but couldn't read frame" << std::endl;
-                    cap.release();
-                }
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    
+    CameraProbe probe(probeCachePath);
+    CameraProbe::Settings settings;
+    settings.preferredWidth = preferredWidth;
+    settings.preferredHeight = preferredHeight;
+    settings.rawYUV = rawYUV;
+    
+    // Try the configuration that worked last time before probing anything else
+    cv::Mat testFrame;
+    CameraProbe::Candidate chosen;
+    bool fromCache = false;
+    if (probe.loadCached(settings, chosen)) {
+        std::cout << "Trying cached camera index " << chosen.index << " with backend " << chosen.backend << std::endl;
+        fromCache = CameraProbe::open(chosen, settings, cap, testFrame) && finishInitialization(testFrame);
+        if (!fromCache) {
+            std::cout << "Cached camera configuration failed, probing" << std::endl;
+            cap.release();
+        }
+    }
+    
+    if (!fromCache) {
+        // Try different camera backends and indices, all device indices at once
+        std::vector<int> backends = {cv::CAP_AVFOUNDATION, cv::CAP_ANY};
+        std::vector<int> indices = {0, 1, 2};
+        std::vector<CameraProbe::Candidate> candidates;
+        for (int backend : backends) {
+            for (int index : indices) {
+                candidates.push_back(CameraProbe::Candidate(backend, index));
+            }
+        }
+        
+        bool opened = CameraProbe::probeConcurrently(candidates, settings, probeTimeoutMs, cap, testFrame, chosen);
+        if (opened) {
+            std::cout << "Camera opened successfully with index " << chosen.index << " and backend " << chosen.backend << std::endl;
+        }
+        if (!opened || !finishInitialization(testFrame)) {
+            if (opened) {
+                std::cout << "Camera opened but couldn't read frame" << std::endl;
+                cap.release();
             }
+            
+            std::cerr << "❌ Error: Could not open any webcam" << std::endl;
+            std::cerr << "Make sure:" << std::endl;
+            std::cerr << "1. Camera permissions are granted to Terminal" << std::endl;
+            std::cerr << "2. No other app is using the camera" << std::endl;
+            std::cerr << "3. Camera is properly connected" << std::endl;
+            active = false;
+            return false;
         }
+        
+        probe.saveCached(settings, chosen);
     }
     
-    std::cerr << "❌ Error: Could not open any webcam" << std::endl;
-    std::cerr << "Make sure:" << std::endl;
-    std::cerr << "1. Camera permissions are granted to Terminal" << std::endl;
-    std::cerr << "2. No other app is using the camera" << std::endl;
-    std::cerr << "3. Camera is properly connected" << std::endl;
-    active = false;
+    startupTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "⏱️  Camera ready in " << startupTimeMs << " ms" << (fromCache ? " (cached configuration)" : "") << std::endl;
+    active = true;
+    return true;
+}
+
+bool WebcamCapture::finishInitialization(cv::Mat& testFrame) {
+    nativeSize = cv::Size(static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH)),
+                          static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT)));
+    
+    FramePacket testPacket;
+    testPacket.image = testFrame;
+    if (!interpretFrame(testPacket)) {
+        std::cout << "Raw frame layout not recognised, falling back to BGR conversion" << std::endl;
+        cap.set(cv::CAP_PROP_CONVERT_RGB, 1);
+        bool readOk = cap.read(testFrame) && !testFrame.empty();
+        testPacket.image = testFrame;
+        if (!readOk || !interpretFrame(testPacket)) {
+            return false;
+        }
+    }
+    
+    // The pool is keyed on the buffer as the backend fills it, before any reshaping
+    latestFrameSize = testFrame.size();
+    latestFrameType = testFrame.type();
+    pixelFormat = testPacket.format;
+    imageSize = testPacket.imageSize();
+    std::cout << "✅ Webcam initialized successfully!" << std::endl;
+    std::cout << "Frame size: " << imageSize.width << "x" << imageSize.height
+              << (pixelFormat == FramePacket::PIXEL_BGR ? " (BGR)" :
+                  pixelFormat == FramePacket::PIXEL_YUYV ? " (raw YUYV)" : " (raw NV12)") << std::endl;
+    return true;
+}
+
+bool WebcamCapture::interpretFrame(FramePacket& packet) const {
+    cv::Mat& image = packet.image;
+    
+    if (image.type() == CV_8UC3) {
+        packet.format = FramePacket::PIXEL_BGR;
+        return true;
+    }
+    if (image.type() == CV_8UC2) {
+        packet.format = FramePacket::PIXEL_YUYV;
+        return true;
+    }
+    
+    // Some backends hand back the raw driver buffer as a single row of bytes
+    if (image.type() == CV_8UC1 && image.isContinuous() && nativeSize.area() > 0) {
+        const size_t pixels = static_cast<size_t>(nativeSize.area());
+        if (image.total() == pixels * 2) {
+            image = image.reshape(2, nativeSize.height);
+            packet.format = FramePacket::PIXEL_YUYV;
+            return true;
+        }
+        if (image.total() == pixels * 3 / 2) {
+            image = image.reshape(1, nativeSize.height * 3 / 2);
+            packet.format = FramePacket::PIXEL_NV12;
+            return true;
+        }
+    }
     return false;
 }
 
-bool WebcamCapture::captureFrame(cv::Mat& frame) {
-    if (!active || !cap.isOpened()) {
+void WebcamCapture::startCaptureThread() {
+    capturing = true;
+    captureThread = std::thread(&WebcamCapture::captureLoop, this);
+    std::cout << "🧵 Background capture thread started" << std::endl;
+}
+
+void WebcamCapture::stopCaptureThread() {
+    capturing = false;
+    frameReady.notify_all();
+    if (captureThread.joinable()) {
+        captureThread.join();
+    }
+}
+
+void WebcamCapture::captureLoop() {
+    CoreBudget::ThreadScope threadScope(CoreBudget::ROLE_CAPTURE, "capture");
+    while (capturing) {
+        // Read into a free pooled buffer; buffers still held by consumers are never overwritten
+        cv::Mat buffer = framePool.acquire(latestFrameSize, latestFrameType);
+        FramePacket captured;
+        bool ok;
+        {
+            std::lock_guard<std::mutex> lock(captureMutex);
+            ok = cap.read(buffer) && !buffer.empty();
+            captured.image = buffer;
+            ok = ok && interpretFrame(captured);
+        }
+        
+        if (!ok) {
+            // Back off briefly instead of spinning if the device stops delivering frames
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+        
+        // Stamp on the capture thread so sequence gaps reveal frames dropped from the mailbox
+        stampPacket(captured);
+        
+        // Publish to the mailbox, discarding the previous frame if nobody took it
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            if (hasNewFrame) {
+                droppedFrames++;
+            }
+            latestPacket = captured;
+            latestFrameSize = buffer.size();
+            latestFrameType = buffer.type();
+            imageSize = captured.imageSize();
+            hasNewFrame = true;
+        }
+        frameReady.notify_all();
+    }
+}
+
+bool WebcamCapture::waitForFrame(std::chrono::milliseconds timeout) {
+    if (!threaded || !capturing) {
+        return true;  // capturePacket() reads directly, or reports the failure
+    }
+    std::unique_lock<std::mutex> lock(frameMutex);
+    return frameReady.wait_for(lock, timeout, [this]() { return hasNewFrame || !capturing; });
+}
+
+bool WebcamCapture::capturePacket(FramePacket& packet) {
+    if (!active) {
         return false;
     }
     
-    return cap.read(frame) && !frame.empty();
+    if (threaded) {
+        // Take the newest frame if there is one; never wait for the camera
+        std::lock_guard<std::mutex> lock(frameMutex);
+        if (!hasNewFrame) {
+            return false;
+        }
+        packet = latestPacket;
+        latestPacket.image.release();
+        hasNewFrame = false;
+        return true;
+    }
+    
+    if (!cap.isOpened()) {
+        return false;
+    }
+    
+    // Swap the caller's previous frame for a pooled buffer and read straight into it
+    cv::Mat buffer = framePool.acquire(latestFrameSize, latestFrameType);
+    packet.image.release();
+    if (!cap.read(buffer) || buffer.empty()) {
+        return false;
+    }
+    
+    packet.image = buffer;
+    if (!interpretFrame(packet)) {
+        return false;
+    }
+    stampPacket(packet);
+    latestFrameSize = buffer.size();
+    latestFrameType = buffer.type();
+    imageSize = packet.imageSize();
+    return true;
 }
 
 void WebcamCapture::release() {
+    stopCaptureThread();
+    
     if (cap.isOpened()) {
         cap.release();
     }
     active = false;
+    
+    std::lock_guard<std::mutex> lock(frameMutex);
+    latestPacket.image.release();
+    hasNewFrame = false;
+    framePool.clear();
 }
 
 cv::Size WebcamCapture::getFrameSize() const {
-    if (!active || !cap.isOpened()) {
+    if (!active) {
+        return cv::Size(0, 0);
+    }
+    
+    if (threaded || pixelFormat != FramePacket::PIXEL_BGR) {
+        // The capture thread owns cap (and raw buffers don't match the reported size),
+        // so report the size of the last delivered picture
+        std::lock_guard<std::mutex> lock(frameMutex);
+        return imageSize;
+    }
+    
+    if (!cap.isOpened()) {
         return cv::Size(0, 0);
     }
     
@@ -84,7 +285,10 @@ void WebcamCapture::setFrameSize(int width, int height) {
     
     // If already initialized, update the settings
     if (active && cap.isOpened()) {
+        std::lock_guard<std::mutex> lock(captureMutex);
         cap.set(cv::CAP_PROP_FRAME_WIDTH, width);
         cap.set(cv::CAP_PROP_FRAME_HEIGHT, height);
+        nativeSize = cv::Size(static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH)),
+                              static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT)));
     }
 }
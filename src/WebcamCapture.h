@@ -3,11 +3,21 @@
 #include <opencv2/opencv.hpp>
 #include <iostream>
 #include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "IWebcamCapture.h"
+#include "FramePool.h"
+#include "CameraProbe.h"
 
 /**
  * OpenCV-based webcam capture implementation.
  * Handles the complexity of initializing webcam across different backends.
+ * In threaded mode a background thread keeps reading from the camera and
+ * capturePacket() hands out the newest frame without blocking.
+ * Frames are read into pooled, reference-counted buffers to avoid per-frame allocation.
+ * The working camera configuration is cached so restarts skip the probing.
  */
 class WebcamCapture : public IWebcamCapture {
 public:
@@ -17,8 +27,8 @@ public:
     // Initialize the webcam with smart backend detection
     bool initialize() override;
     
-    // Capture a frame from the webcam
-    bool captureFrame(cv::Mat& frame) override;
+    // Capture a frame from the webcam (non-blocking in threaded mode)
+    bool capturePacket(FramePacket& packet) override;
     
     // Check if webcam is active/initialized
     bool isActive() const override { return active; }
@@ -29,15 +39,85 @@ public:
     // Get frame dimensions
     cv::Size getFrameSize() const override;
     
+    // Frames overwritten in the mailbox before capturePacket() picked them up
+    uint64_t getDroppedFrameCount() const override { return droppedFrames; }
+    
+    // Frame buffers allocated by the capture pool
+    uint64_t getBufferAllocationCount() const override { return framePool.getAllocationCount(); }
+    
+    // The capture thread holds two buffers of its own (the one being read and the mailbox)
+    void reserveFrameBuffers(size_t frames) override { framePool.reserve(frames + 2); }
+    
+    // Wait for the capture thread to publish a frame (returns at once when it isn't running)
+    bool waitForFrame(std::chrono::milliseconds timeout) override;
+    
     // Optional: Set frame size (call before initialize())
     void setFrameSize(int width, int height);
     
+    // Optional: Read frames on a background thread (call before initialize())
+    void setThreadedCapture(bool enabled) { threaded = enabled; }
+    
+    // Optional: Ask the backend for raw YUYV/NV12 frames instead of converting to BGR
+    // (call before initialize()). Falls back to BGR if the backend can't deliver them.
+    void setRawYUV(bool enabled) { rawYUV = enabled; }
+    
+    // Optional: Where the last working camera configuration is cached; relative paths go in the
+    // user cache directory (call before initialize())
+    void setProbeCachePath(const std::string& path) { probeCachePath = path; }
+    
+    // Optional: How long to wait for the concurrent camera probes (call before initialize())
+    void setProbeTimeout(int milliseconds) { probeTimeoutMs = milliseconds; }
+    
+    // Time initialize() took to get a working camera
+    double getStartupTimeMs() const override { return startupTimeMs; }
+
 private:
     cv::VideoCapture cap;
     bool active;
     int preferredWidth;
     int preferredHeight;
     
+    // Frames are read into pooled buffers that return to the pool when consumers let go.
+    // latestFrameSize/Type describe the buffer as the backend fills it (the pool key),
+    // imageSize the picture itself.
+    FramePool framePool;
+    int latestFrameType;
+    cv::Size imageSize;
+    
+    // Raw YUV ingestion
+    bool rawYUV;
+    cv::Size nativeSize;
+    FramePacket::PixelFormat pixelFormat;
+    
+    // Threaded capture state
+    bool threaded;
+    std::thread captureThread;
+    std::atomic<bool> capturing;
+    std::mutex captureMutex;        // Guards cap while the capture thread is running
+    mutable std::mutex frameMutex;  // Guards the latest-frame mailbox below
+    std::condition_variable frameReady;
+    FramePacket latestPacket;
+    bool hasNewFrame;
+    cv::Size latestFrameSize;
+    std::atomic<uint64_t> droppedFrames;
+    
+    // Startup
+    std::string probeCachePath;
+    int probeTimeoutMs;
+    double startupTimeMs;
+    
     // Helper method to try different camera configurations
     bool tryInitializeCamera();
+    
+    // Work out the frame layout from the first frame of a freshly opened camera
+    bool finishInitialization(cv::Mat& testFrame);
+    
+    // Work out the pixel format of a frame as delivered by the backend, reshaping flat raw
+    // buffers into an image view. Returns false for layouts we don't understand.
+    bool interpretFrame(FramePacket& packet) const;
+    
+    // Background capture thread helpers
+    void startCaptureThread();
+    void stopCaptureThread();
+    void captureLoop();
 };
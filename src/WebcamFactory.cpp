@@ -1,16 +1,41 @@
 #include "WebcamFactory.h"
 #include "WebcamCapture.h"
+#include "VideoFileCapture.h"
+#include "ImageSequenceCapture.h"
+#include "SyntheticCapture.h"
+#include <cstdio>
 #include <iostream>
 
+namespace {
+
+// Initialize a freshly constructed source, returning it only if it came up
+std::unique_ptr<IWebcamCapture> initializeSource(std::unique_ptr<IWebcamCapture> source, const std::string& name) {
+    if (source->initialize()) {
+        std::cout << "✅ Created " << name << " source successfully" << std::endl;
+        return source;
+    }
+    
+    std::cerr << "❌ Failed to initialize " << name << " source" << std::endl;
+    return std::unique_ptr<IWebcamCapture>();
+}
+
+}
+
 std::unique_ptr<IWebcamCapture> WebcamFactory::create() {
     return create(640, 480); // Default resolution
 }
 
 std::unique_ptr<IWebcamCapture> WebcamFactory::create(int width, int height) {
+    return create(width, height, false);
+}
+
+std::unique_ptr<IWebcamCapture> WebcamFactory::create(int width, int height, bool threaded, bool rawYUV) {
     std::unique_ptr<WebcamCapture> webcam(new WebcamCapture());
     
-    // Set preferred frame size before initialization
+    // Set preferred frame size and capture mode before initialization
     webcam->setFrameSize(width, height);
+    webcam->setThreadedCapture(threaded);
+    webcam->setRawYUV(rawYUV);
     
     if (webcam->initialize()) {
         std::cout << "✅ Created webcam capture successfully" << std::endl;
@@ -20,3 +45,48 @@ std::unique_ptr<IWebcamCapture> WebcamFactory::create(int width, int height) {
         return std::unique_ptr<IWebcamCapture>();
     }
 }
+
+std::unique_ptr<IWebcamCapture> WebcamFactory::createVideoFile(const std::string& path, bool realTime) {
+    return initializeSource(std::unique_ptr<IWebcamCapture>(new VideoFileCapture(path, realTime)), "video file");
+}
+
+std::unique_ptr<IWebcamCapture> WebcamFactory::createImageSequence(const std::string& directory, double fps, bool realTime) {
+    return initializeSource(std::unique_ptr<IWebcamCapture>(new ImageSequenceCapture(directory, fps, realTime)), "image sequence");
+}
+
+std::unique_ptr<IWebcamCapture> WebcamFactory::createSynthetic(int width, int height, double fps, bool realTime) {
+    return initializeSource(std::unique_ptr<IWebcamCapture>(new SyntheticCapture(width, height, fps, realTime)), "synthetic");
+}
+
+std::unique_ptr<IWebcamCapture> WebcamFactory::createFromSpec(const std::string& spec, bool realTime) {
+    if (spec.empty() || spec == "camera") {
+        return create(640, 480, true);
+    }
+    if (spec == "camera:yuv") {
+        return create(640, 480, true, true);
+    }
+    
+    size_t colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    std::string argument = (colon == std::string::npos) ? "" : spec.substr(colon + 1);
+    
+    if (kind == "video" && !argument.empty()) {
+        return createVideoFile(argument, realTime);
+    }
+    if (kind == "images" && !argument.empty()) {
+        return createImageSequence(argument, 30.0, realTime);
+    }
+    if (kind == "synthetic") {
+        int width = 640;
+        int height = 480;
+        if (!argument.empty() && std::sscanf(argument.c_str(), "%dx%d", &width, &height) != 2) {
+            std::cerr << "❌ Invalid synthetic size '" << argument << "', expected <width>x<height>" << std::endl;
+            return std::unique_ptr<IWebcamCapture>();
+        }
+        return createSynthetic(width, height, 30.0, realTime);
+    }
+    
+    std::cerr << "❌ Unknown frame source '" << spec << "'" << std::endl;
+    std::cerr << "Expected camera, camera:yuv, video:<file>, images:<directory> or synthetic[:<width>x<height>]" << std::endl;
+    return std::unique_ptr<IWebcamCapture>();
+}
@@ -2,10 +2,13 @@
 
 #include "IWebcamCapture.h"
 #include <memory>
+#include <string>
 
 /**
  * Factory for creating webcam capture instances.
  * This makes it easy for any demo to get webcam functionality.
+ * Replayed and synthetic sources implement the same interface, so demos can
+ * run and be benchmarked without a camera.
  */
 class WebcamFactory {
 public:
@@ -22,4 +25,55 @@ public:
      * @return Unique pointer to the created webcam capture, or nullptr if creation failed
      */
     static std::unique_ptr<IWebcamCapture> create(int width, int height);
+    
+    /**
+     * Create a webcam capture instance, optionally reading frames on a background thread.
+     * In threaded mode captureFrame() never blocks and returns false until a new frame arrives.
+     * @param width Preferred frame width
+     * @param height Preferred frame height
+     * @param threaded Whether to capture on a dedicated thread
+     * @param rawYUV Keep frames in the camera's YUYV/NV12 layout instead of converting to BGR
+     * @return Unique pointer to the created webcam capture, or nullptr if creation failed
+     */
+    static std::unique_ptr<IWebcamCapture> create(int width, int height, bool threaded, bool rawYUV = false);
+    
+    /**
+     * Create a source that replays a video file, looping at the end.
+     * @param path Path to the video file
+     * @param realTime Pace frames to the file's frame rate, or deliver them as fast as possible
+     * @return Unique pointer to the created source, or nullptr if creation failed
+     */
+    static std::unique_ptr<IWebcamCapture> createVideoFile(const std::string& path, bool realTime = true);
+    
+    /**
+     * Create a source that plays back a directory of images in file name order, looping at the end.
+     * @param directory Directory containing the images
+     * @param fps Playback frame rate in real-time mode
+     * @param realTime Pace frames to fps, or deliver them as fast as possible
+     * @return Unique pointer to the created source, or nullptr if creation failed
+     */
+    static std::unique_ptr<IWebcamCapture> createImageSequence(const std::string& directory, double fps = 30.0, bool realTime = true);
+    
+    /**
+     * Create a source that generates a deterministic moving test pattern.
+     * @param width Frame width
+     * @param height Frame height
+     * @param fps Frame rate in real-time mode
+     * @param realTime Pace frames to fps, or deliver them as fast as possible
+     * @return Unique pointer to the created source, or nullptr if creation failed
+     */
+    static std::unique_ptr<IWebcamCapture> createSynthetic(int width = 640, int height = 480, double fps = 30.0, bool realTime = true);
+    
+    /**
+     * Create a source from a command-line style description:
+     *   "camera"                      live webcam (threaded capture)
+     *   "camera:yuv"                  live webcam delivering raw YUYV/NV12 frames
+     *   "video:<file>"                video file replay
+     *   "images:<directory>"          image sequence replay
+     *   "synthetic[:<width>x<height>]" generated test pattern
+     * @param spec Source description
+     * @param realTime Pace replayed and synthetic sources (ignored for the camera)
+     * @return Unique pointer to the created source, or nullptr if creation failed
+     */
+    static std::unique_ptr<IWebcamCapture> createFromSpec(const std::string& spec, bool realTime = true);
 };
@@ -1,6 +1,13 @@
 #include <GLFW/glfw3.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
 #include "SimpleCubeViewer.h"
+#include "CoreBudget.h"
+#include "TaskScheduler.h"
+#include "FrameContext.h"
 
 // Global variables
 SimpleCubeViewer* cubeViewer = nullptr;
@@ -43,7 +50,39 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
+    // Optional arguments: a frame source spec, --fast to run replayed sources unpaced and
+    // --auto-backend to benchmark the DNN configurations at startup. --depth-budget MS switches
+    // depth model and resolution at runtime to stay within MS per inference. --cores SPEC pins
+    // capture, inference and rendering to their own CPUs (see CoreBudget). --depth-tier picks MiDaS
+    // (neural), classical cues (low-power) or MiDaS with fallback (auto).
+    std::string sourceSpec = "camera";
+    bool realTime = true;
+    bool autoSelectBackend = false;
+    double depthBudgetMs = 0.0;
+    std::string coreSpec;
+    DepthEstimatorFactory::Tier depthTier = DepthEstimatorFactory::TIER_AUTO;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--fast") == 0) {
+            realTime = false;
+        } else if (std::strcmp(argv[i], "--auto-backend") == 0) {
+            autoSelectBackend = true;
+        } else if (std::strcmp(argv[i], "--depth-tier") == 0 && i + 1 < argc) {
+            if (!DepthEstimatorFactory::parseTier(argv[++i], depthTier)) {
+                return -1;
+            }
+        } else if (std::strcmp(argv[i], "--cores") == 0 && i + 1 < argc) {
+            coreSpec = argv[++i];
+        } else if (std::strcmp(argv[i], "--depth-budget") == 0 && i + 1 < argc) {
+            depthBudgetMs = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            std::cout << "Usage: " << argv[0] << " [camera|video:<file>|images:<dir>|synthetic[:WxH]] [--fast] [--auto-backend] [--depth-budget MS] [--depth-tier auto|neural|low-power] [--cores auto|capture=CPUS,inference=CPUS,render=CPUS]" << std::endl;
+            return 0;
+        } else {
+            sourceSpec = argv[i];
+        }
+    }
+    
     std::cout << "=== Simple 3D Cube Demo ===" << std::endl;
     std::cout << "Initializing 3D cube viewer..." << std::endl;
     
@@ -73,11 +112,20 @@ int main() {
     glfwSetCursorPosCallback(window, cursor_position_callback);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     
-    // Enable V-Sync
-    glfwSwapInterval(1);
+    // Enable V-Sync (disabled in --fast mode so throughput isn't capped at the display rate)
+    glfwSwapInterval(realTime ? 1 : 0);
+    
+    // Split the cores before any worker threads start
+    if (!coreSpec.empty() && !CoreBudget::configure(coreSpec)) {
+        std::cout << "Continuing without a core budget" << std::endl;
+    }
     
     // Initialize cube viewer
     cubeViewer = new SimpleCubeViewer();
+    cubeViewer->setFrameSource(sourceSpec, realTime);
+    cubeViewer->setAutoSelectBackend(autoSelectBackend);
+    cubeViewer->setDepthLatencyBudget(depthBudgetMs);
+    cubeViewer->setDepthTier(depthTier);
     if (!cubeViewer->initialize(window)) {
         std::cerr << "Failed to initialize cube viewer" << std::endl;
         delete cubeViewer;
@@ -87,6 +135,12 @@ int main() {
     
     std::cout << "🎮 3D Cube Demo is ready!" << std::endl;
     
+    // OpenCV's workers go on the inference cores, this thread on the render cores
+    CoreBudget::applyInferenceThreads();
+    CoreBudget::ThreadScope renderScope(CoreBudget::ROLE_RENDER, "render");
+    
+    auto loopStart = std::chrono::steady_clock::now();
+    
     // Main render loop
     while (!glfwWindowShouldClose(window)) {
         // Render the scene
@@ -101,6 +155,21 @@ int main() {
     
     std::cout << "Closing 3D cube demo..." << std::endl;
     
+    double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loopStart).count();
+    uint64_t processedFrames = cubeViewer->getProcessedFrameCount();
+    if (processedFrames > 0 && elapsedSeconds > 0) {
+        std::cout << "Processed " << processedFrames << " frames at "
+                  << (processedFrames / elapsedSeconds) << " FPS" << std::endl;
+        std::cout << cubeViewer->getFrameStatsSummary() << std::endl;
+        std::cout << cubeViewer->getDepthGateSummary() << std::endl;
+        if (depthBudgetMs > 0.0) {
+            std::cout << cubeViewer->getDepthQualitySummary() << std::endl;
+        }
+        std::cout << FrameContext::summary() << std::endl;
+        std::cout << TaskScheduler::shared().summary() << std::endl;
+        std::cout << CoreBudget::cpuTimeSummary() << std::endl;
+    }
+    
     // Clean up
     delete cubeViewer;
     glfwTerminate();
@@ -3,23 +3,46 @@
 #include <iostream>
 #include "DepthEstimatorFactory.h"
 #include "WebcamFactory.h"
+#include "FrameStats.h"
+#include "FrameProcessor.h"
+#include "AsyncDepthEstimator.h"
+#include "AllocationCounter.h"
+#include "CoreBudget.h"
+#include "MotionGatedDepthEstimator.h"
+#include "RoiDepthEstimator.h"
+#include "AdaptiveDepthEstimator.h"
+#include "FrameContext.h"
+#include "FramePipeline.h"
+#include "TaskScheduler.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 
 // Global variables
 std::unique_ptr<IWebcamCapture> webcam;
-cv::Mat frame;
+FramePacket packet;
+FrameStats frameStats;
 GLuint textureID;
+bool textureReady = false;
 
-// Simple edge detection toggle
-bool edgeDetectionEnabled = false;
+// Texture upload buffer reused across frames
+cv::Mat textureBuffer;
 
-// Face detection toggle and classifier
-bool faceDetectionEnabled = false;
-cv::CascadeClassifier faceCascade;
+// Edge, face and depth effects (toggled from the keyboard)
+FrameProcessor frameProcessor;
 
-// Depth estimation toggle and estimator
-bool depthEstimationEnabled = false;
-std::unique_ptr<IDepthEstimator> depthEstimator;
+// Depth estimator used by the processor; runs on its own thread so rendering keeps camera rate
+std::unique_ptr<AsyncDepthEstimator> depthEstimator;
+
+// Change detector in front of the model (owned by depthEstimator); reuses depth for still scenes
+MotionGatedDepthEstimator* depthGate = nullptr;
+
+// Refines depth inside detected faces (owned by depthEstimator)
+RoiDepthEstimator* depthRoi = nullptr;
+
+// Switches depth model and resolution to hold the latency budget (owned by depthEstimator; null without --depth-budget)
+AdaptiveDepthEstimator* depthQuality = nullptr;
 
 // Error callback function
 void error_callback(int error, const char* description) {
@@ -32,26 +55,33 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
         glfwSetWindowShouldClose(window, GLFW_TRUE);
     }
     if (key == GLFW_KEY_E && action == GLFW_PRESS) {
-        edgeDetectionEnabled = !edgeDetectionEnabled;
-        std::cout << "Edge detection: " << (edgeDetectionEnabled ? "ON" : "OFF") << std::endl;
+        frameProcessor.setEdgeDetection(!frameProcessor.isEdgeDetectionEnabled());
+        std::cout << "Edge detection: " << (frameProcessor.isEdgeDetectionEnabled() ? "ON" : "OFF") << std::endl;
     }
     if (key == GLFW_KEY_F && action == GLFW_PRESS) {
-        faceDetectionEnabled = !faceDetectionEnabled;
-        std::cout << "Face detection: " << (faceDetectionEnabled ? "ON" : "OFF") << std::endl;
+        frameProcessor.setFaceDetection(!frameProcessor.isFaceDetectionEnabled());
+        std::cout << "Face detection: " << (frameProcessor.isFaceDetectionEnabled() ? "ON" : "OFF") << std::endl;
     }
     if (key == GLFW_KEY_D && action == GLFW_PRESS) {
-        depthEstimationEnabled = !depthEstimationEnabled;
-        std::cout << "Depth estimation: " << (depthEstimationEnabled ? "ON" : "OFF") << std::endl;
+        frameProcessor.setDepthEstimation(!frameProcessor.isDepthEstimationEnabled());
+        std::cout << "Depth estimation: " << (frameProcessor.isDepthEstimationEnabled() ? "ON" : "OFF") << std::endl;
+    }
+    if (key == GLFW_KEY_R && action == GLFW_PRESS && depthRoi) {
+        depthRoi->setEnabled(!depthRoi->isEnabled());
+        std::cout << "Face depth refinement: " << (depthRoi->isEnabled() ? "ON" : "OFF") << std::endl;
+        if (depthRoi->isEnabled() && !frameProcessor.isFaceDetectionEnabled()) {
+            std::cout << "  (turn on face detection with F to supply the regions)" << std::endl;
+        }
     }
 }
 
-// Initialize webcam
-bool initWebcam() {
-    // Create webcam using the factory
-    webcam = WebcamFactory::create();
+// Initialize webcam (or a replayed/synthetic source, see WebcamFactory::createFromSpec)
+bool initWebcam(const std::string& sourceSpec, bool realTime) {
+    // Create webcam using the factory; the live camera captures on a background thread
+    webcam = WebcamFactory::createFromSpec(sourceSpec, realTime);
     
     if (webcam && webcam->isActive()) {
-        std::cout << "✅ Webcam initialized successfully!" << std::endl;
+        std::cout << "✅ Webcam initialized successfully! (startup " << webcam->getStartupTimeMs() << " ms)" << std::endl;
         return true;
     } else {
         std::cerr << "❌ Error: Could not initialize webcam" << std::endl;
@@ -61,32 +91,29 @@ bool initWebcam() {
 
 // Initialize face detection
 bool initFaceDetection() {
-    // Try to load the frontal face cascade classifier
-    std::vector<std::string> cascadePaths = {
-        "/opt/homebrew/share/opencv4/haarcascades/haarcascade_frontalface_alt.xml",
-        "/usr/local/share/opencv4/haarcascades/haarcascade_frontalface_alt.xml",
-        "/usr/share/opencv4/haarcascades/haarcascade_frontalface_alt.xml",
-        "haarcascade_frontalface_alt.xml"
-    };
-    
-    for (const std::string& path : cascadePaths) {
-        if (faceCascade.load(path)) {
-            std::cout << "✅ Face cascade loaded from: " << path << std::endl;
-            return true;
-        }
-    }
-    
-    std::cerr << "❌ Error: Could not load face cascade classifier" << std::endl;
-    std::cerr << "Make sure OpenCV haarcascades are installed" << std::endl;
-    return false;
+    return frameProcessor.loadFaceCascade();
 }
 
 // Initialize depth estimation
-bool initDepthEstimation() {
+bool initDepthEstimation(DepthEstimatorFactory::Tier depthTier, double motionThreshold, bool autoSelectBackend, double latencyBudgetMs) {
     // Create depth estimator using the factory with default paths
-    depthEstimator = DepthEstimatorFactory::createWithDefaultPaths();
+    std::unique_ptr<IDepthEstimator> estimator;
+    if (latencyBudgetMs > 0.0 && depthTier != DepthEstimatorFactory::TIER_LOW_POWER) {
+        std::unique_ptr<AdaptiveDepthEstimator> adaptive = DepthEstimatorFactory::createAdaptive(latencyBudgetMs, autoSelectBackend);
+        depthQuality = adaptive.get();
+        estimator = std::move(adaptive);
+        if (!estimator && depthTier == DepthEstimatorFactory::TIER_AUTO) {
+            estimator = DepthEstimatorFactory::createClassical();
+        }
+    } else {
+        estimator = DepthEstimatorFactory::createForTier(depthTier, autoSelectBackend);
+    }
     
-    if (depthEstimator) {
+    if (estimator) {
+        depthRoi = new RoiDepthEstimator(std::move(estimator));
+        depthGate = new MotionGatedDepthEstimator(std::unique_ptr<IDepthEstimator>(depthRoi));
+        depthGate->setMotionThreshold(motionThreshold);
+        depthEstimator = std::unique_ptr<AsyncDepthEstimator>(new AsyncDepthEstimator(std::unique_ptr<IDepthEstimator>(depthGate)));
         std::cout << "✅ Depth estimation initialized successfully" << std::endl;
         return true;
     } else {
@@ -95,85 +122,27 @@ bool initDepthEstimation() {
     }
 }
 
-// Process frame with edge detection, face detection, and/or depth estimation
-cv::Mat processFrame(const cv::Mat& inputFrame) {
-    if (inputFrame.empty()) {
-        return inputFrame;
-    }
-    
-    cv::Mat result = inputFrame.clone();
-    
-    // Apply edge detection if enabled
-    if (edgeDetectionEnabled) {
-        cv::Mat gray, edges;
-        cv::cvtColor(inputFrame, gray, cv::COLOR_BGR2GRAY);
-        cv::Canny(gray, edges, 50, 150);
-        cv::cvtColor(edges, result, cv::COLOR_GRAY2BGR);
-    }
-    
-    // Apply depth estimation if enabled
-    if (depthEstimationEnabled && depthEstimator && depthEstimator->isInitialized()) {
-        cv::Mat depthMap = depthEstimator->estimateDepth(inputFrame);
-        if (!depthMap.empty()) {
-            // Overlay depth heat map on the current result
-            result = depthEstimator->overlayDepthHeatMap(result, depthMap, 0.9f);
-        }
-    }
-    
-    // Apply face detection if enabled
-    if (faceDetectionEnabled && !faceCascade.empty()) {
-        cv::Mat gray;
-        cv::cvtColor(inputFrame, gray, cv::COLOR_BGR2GRAY);
-        
-        std::vector<cv::Rect> faces;
-        faceCascade.detectMultiScale(gray, faces, 1.1, 3, 0, cv::Size(30, 30));
-        
-        // Draw bounding boxes around detected faces
-        for (const cv::Rect& face : faces) {
-            cv::rectangle(result, face, cv::Scalar(0, 255, 0), 2);
-            
-            // Add a label
-            std::string label = "Face";
-            int baseline;
-            cv::Size labelSize = cv::getTextSize(label, cv::FONT_HERSHEY_SIMPLEX, 0.5, 1, &baseline);
-            cv::Point labelPos(face.x, face.y - 10);
-            
-            // Ensure label is within frame bounds
-            if (labelPos.y < 0) labelPos.y = face.y + labelSize.height + 10;
-            
-            cv::putText(result, label, labelPos, cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(0, 255, 0), 1);
-        }
-        
-        // Print number of faces detected
-        static int frameCount = 0;
-        frameCount++;
-        if (frameCount % 30 == 0) { // Print every 30 frames to avoid spam
-            std::cout << "Detected " << faces.size() << " face(s)" << std::endl;
-        }
-    }
-    
-    return result;
+// Upload an image that is already flipped for OpenGL, stamping the packet it came from
+void uploadTexture(const cv::Mat& flipped, FramePacket& framePacket) {
+    // The texture takes BGR directly so no channel swap is needed
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, flipped.cols, flipped.rows, 0, GL_BGR, GL_UNSIGNED_BYTE, flipped.data);
+    textureReady = true;
+    framePacket.markStage(FramePacket::STAGE_UPLOAD);
 }
 
-// Convert OpenCV Mat to OpenGL texture
-void matToTexture(const cv::Mat& mat) {
+// Convert OpenCV Mat to OpenGL texture, stamping the packet it came from
+void matToTexture(const cv::Mat& mat, FramePacket& framePacket) {
     if (mat.empty()) return;
     
-    // Convert BGR to RGB
-    cv::Mat rgbMat;
-    cv::cvtColor(mat, rgbMat, cv::COLOR_BGR2RGB);
-    
     // Flip vertically for OpenGL
-    cv::flip(rgbMat, rgbMat, 0);
-    
-    // Update texture
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, rgbMat.cols, rgbMat.rows, 0, GL_RGB, GL_UNSIGNED_BYTE, rgbMat.data);
+    cv::flip(mat, textureBuffer, 0);
+    uploadTexture(textureBuffer, framePacket);
 }
 
 // Render the texture
 void renderTexture(int windowWidth, int windowHeight) {
-    if (!webcam || !webcam->isActive()) return;
+    if (!webcam || !webcam->isActive() || !textureReady) return;
     
     glEnable(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, textureID);
@@ -197,7 +166,63 @@ void renderTexture(int windowWidth, int windowHeight) {
     glDisable(GL_TEXTURE_2D);
 }
 
-int main() {
+int main(int argc, char** argv) {
+    // Optional arguments: a frame source spec, --fast to run replayed sources unpaced and
+    // --count-allocs to report Mat allocations made by depth estimation. --motion-threshold
+    // sets how much the scene must change before depth is re-estimated (0 = every frame).
+    // --auto-backend benchmarks the DNN configurations at startup and keeps the fastest.
+    // --depth-budget MS switches depth model and resolution at runtime to stay within MS per inference.
+    // --cores SPEC pins capture, inference and rendering to their own CPUs (see CoreBudget).
+    // --depth-tier picks MiDaS (neural), classical cues (low-power) or MiDaS with fallback (auto).
+    // --face-interval N runs the face cascade every N frames and tracks faces in between.
+    // --edge-level N finds edges on a 1/2^N size image (0 = full resolution).
+    // --task-threads N sizes the scheduler the effects run on (default: one per inference core).
+    // --pipeline N overlaps capture, processing and display of consecutive frames, with
+    // queues of N frames between the steps (0 = one frame at a time).
+    std::string sourceSpec = "camera";
+    bool realTime = true;
+    double motionThreshold = 2.0;
+    bool autoSelectBackend = false;
+    double latencyBudgetMs = 0.0;
+    std::string coreSpec;
+    DepthEstimatorFactory::Tier depthTier = DepthEstimatorFactory::TIER_AUTO;
+    int faceInterval = 10;
+    int edgeLevel = 0;
+    int pipelineDepth = 0;
+    int taskThreads = 0;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--fast") == 0) {
+            realTime = false;
+        } else if (std::strcmp(argv[i], "--auto-backend") == 0) {
+            autoSelectBackend = true;
+        } else if (std::strcmp(argv[i], "--motion-threshold") == 0 && i + 1 < argc) {
+            motionThreshold = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--depth-tier") == 0 && i + 1 < argc) {
+            if (!DepthEstimatorFactory::parseTier(argv[++i], depthTier)) {
+                return -1;
+            }
+        } else if (std::strcmp(argv[i], "--face-interval") == 0 && i + 1 < argc) {
+            faceInterval = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--edge-level") == 0 && i + 1 < argc) {
+            edgeLevel = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--pipeline") == 0 && i + 1 < argc) {
+            pipelineDepth = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--task-threads") == 0 && i + 1 < argc) {
+            taskThreads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--cores") == 0 && i + 1 < argc) {
+            coreSpec = argv[++i];
+        } else if (std::strcmp(argv[i], "--depth-budget") == 0 && i + 1 < argc) {
+            latencyBudgetMs = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--count-allocs") == 0) {
+            AllocationCounter::install();
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            std::cout << "Usage: " << argv[0] << " [camera|video:<file>|images:<dir>|synthetic[:WxH]] [--fast] [--count-allocs] [--motion-threshold T] [--auto-backend] [--depth-budget MS] [--depth-tier auto|neural|low-power] [--face-interval N] [--edge-level N] [--pipeline N] [--task-threads N] [--cores auto|capture=CPUS,inference=CPUS,render=CPUS]" << std::endl;
+            return 0;
+        } else {
+            sourceSpec = argv[i];
+        }
+    }
+    
     std::cout << "=== Webcam CV Demo ===" << std::endl;
     std::cout << "Initializing window and webcam..." << std::endl;
     
@@ -222,8 +247,8 @@ int main() {
     glfwMakeContextCurrent(window);
     glfwSetKeyCallback(window, key_callback);
     
-    // Enable V-Sync
-    glfwSwapInterval(1);
+    // Enable V-Sync (disabled in --fast mode so throughput isn't capped at the display rate)
+    glfwSwapInterval(realTime ? 1 : 0);
     
     // Initialize OpenGL texture
     glGenTextures(1, &textureID);
@@ -231,26 +256,41 @@ int main() {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     
+    // Split the cores before any worker threads start
+    if (!coreSpec.empty() && !CoreBudget::configure(coreSpec)) {
+        std::cout << "Continuing without a core budget" << std::endl;
+    }
+    if (taskThreads > 0) {
+        TaskScheduler::setWorkerCount(taskThreads);
+    }
+    
     // Initialize webcam
-    bool webcamActive = initWebcam();
+    bool webcamActive = initWebcam(sourceSpec, realTime);
     
     // Initialize face detection
     bool faceDetectionAvailable = initFaceDetection();
+    frameProcessor.getFaceTracker().setDetectionInterval(faceInterval);
+    frameProcessor.getEdgeDetector().setPyramidLevel(edgeLevel);
     
     // Initialize depth estimation
-    bool depthEstimationAvailable = initDepthEstimation();
+    bool depthEstimationAvailable = initDepthEstimation(depthTier, motionThreshold, autoSelectBackend, latencyBudgetMs);
+    
+    // OpenCV's workers go on the inference cores, this thread on the render cores
+    CoreBudget::applyInferenceThreads();
+    CoreBudget::ThreadScope renderScope(CoreBudget::ROLE_RENDER, "render");
     
     if (webcamActive) {
         std::cout << "🎥 Live webcam feed active! Controls:" << std::endl;
         std::cout << "  ESC - Exit" << std::endl;
-        std::cout << "  E   - Toggle edge detection (currently " << (edgeDetectionEnabled ? "ON" : "OFF") << ")" << std::endl;
+        std::cout << "  E   - Toggle edge detection (currently " << (frameProcessor.isEdgeDetectionEnabled() ? "ON" : "OFF") << ")" << std::endl;
         if (faceDetectionAvailable) {
-            std::cout << "  F   - Toggle face detection (currently " << (faceDetectionEnabled ? "ON" : "OFF") << ")" << std::endl;
+            std::cout << "  F   - Toggle face detection (currently " << (frameProcessor.isFaceDetectionEnabled() ? "ON" : "OFF") << ")" << std::endl;
         } else {
             std::cout << "  F   - Face detection (unavailable - cascade not loaded)" << std::endl;
         }
         if (depthEstimationAvailable) {
-            std::cout << "  D   - Toggle depth estimation heat map (currently " << (depthEstimationEnabled ? "ON" : "OFF") << ")" << std::endl;
+            std::cout << "  D   - Toggle depth estimation heat map (currently " << (frameProcessor.isDepthEstimationEnabled() ? "ON" : "OFF") << ")" << std::endl;
+            std::cout << "  R   - Toggle extra depth detail on detected faces (currently OFF)" << std::endl;
         } else {
             std::cout << "  D   - Depth estimation (unavailable - model not loaded)" << std::endl;
         }
@@ -258,6 +298,26 @@ int main() {
         std::cout << "Webcam failed to initialize. Showing colored background. Press ESC to close." << std::endl;
     }
     
+    // Pipelined mode: capture/prepare and processing run on their own threads and this loop
+    // only uploads and shows finished frames
+    std::unique_ptr<FramePipeline> pipeline;
+    if (webcamActive && pipelineDepth > 0) {
+        pipeline = std::unique_ptr<FramePipeline>(new FramePipeline(*webcam, frameProcessor, depthEstimator.get(), pipelineDepth));
+        pipeline->setFinishFunction([](const cv::Mat& processed, cv::Mat& output) {
+            cv::flip(processed, output, 0);
+        });
+        pipeline->setProcessedCallback([](const FramePacket&) {
+            if (depthRoi) {
+                depthRoi->setRegions(frameProcessor.getFaces());
+            }
+        });
+        pipeline->start();
+    }
+    
+    // Throughput of processed frames, reported on exit
+    uint64_t processedFrames = 0;
+    auto loopStart = std::chrono::steady_clock::now();
+    
     // Main render loop
     while (!glfwWindowShouldClose(window)) {
         // Get window size
@@ -266,15 +326,36 @@ int main() {
         glViewport(0, 0, width, height);
         
         // Clear the screen
-        if (webcam && webcam->isActive()) {
-            // Capture frame from webcam
-            if (webcam->captureFrame(frame) && !frame.empty()) {
+        bool newFrame = false;
+        if (pipeline) {
+            // Show the next finished frame, if the pipeline has one
+            FramePipeline::Output output;
+            if (pipeline->tryGetOutput(output)) {
+                packet = output.packet;
+                uploadTexture(output.image, packet);
+                processedFrames++;
+                newFrame = true;
+            }
+            glClear(GL_COLOR_BUFFER_BIT);
+            renderTexture(width, height);
+        } else if (webcam && webcam->isActive()) {
+            // Capture frame from webcam (non-blocking; false until a new frame is ready)
+            if (webcam->capturePacket(packet) && !packet.image.empty()) {
                 // Process frame (apply edge detection if enabled)
-                cv::Mat processedFrame = processFrame(frame);
-                matToTexture(processedFrame);
-                glClear(GL_COLOR_BUFFER_BIT);
-                renderTexture(width, height);
+                cv::Mat processedFrame = frameProcessor.process(packet, depthEstimator.get());
+                
+                // Faces found in this frame are the depth regions of interest for the next one
+                if (depthRoi) {
+                    depthRoi->setRegions(frameProcessor.getFaces());
+                }
+                matToTexture(processedFrame, packet);
+                processedFrames++;
+                newFrame = true;
             }
+            
+            // Keep drawing the last uploaded frame while the camera catches up
+            glClear(GL_COLOR_BUFFER_BIT);
+            renderTexture(width, height);
         } else {
             // Fallback: colored background
             glClearColor(0.2f, 0.3f, 0.8f, 1.0f);
@@ -284,16 +365,59 @@ int main() {
         // Swap front and back buffers
         glfwSwapBuffers(window);
         
+        // The new frame is on screen: record its capture-to-display latency
+        if (newFrame) {
+            packet.markStage(FramePacket::STAGE_DISPLAY);
+            frameStats.record(packet);
+        }
+        
         // Poll for and process events
         glfwPollEvents();
     }
     
     std::cout << "Closing webcam and window..." << std::endl;
+    if (pipeline) {
+        pipeline->stop();
+    }
+    
+    double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loopStart).count();
+    if (processedFrames > 0 && elapsedSeconds > 0) {
+        std::cout << "Processed " << processedFrames << " frames at "
+                  << (processedFrames / elapsedSeconds) << " FPS" << std::endl;
+        std::cout << frameStats.summary() << std::endl;
+        std::cout << frameProcessor.getStageGraph().summary() << std::endl;
+        if (pipeline) {
+            std::cout << pipeline->summary() << std::endl;
+        }
+        if (frameProcessor.getEdgeDetector().getFrameCount() > 0) {
+            std::cout << frameProcessor.getEdgeDetector().summary() << std::endl;
+        }
+        if (frameProcessor.getFaceTracker().getDetectionCount() > 0) {
+            std::cout << frameProcessor.getFaceTracker().summary() << std::endl;
+        }
+        std::cout << FrameContext::summary() << std::endl;
+        std::cout << TaskScheduler::shared().summary() << std::endl;
+    }
     
     // Clean up
     if (webcam) {
+        std::cout << "Capture dropped " << webcam->getDroppedFrameCount() << " stale frame(s), allocated "
+                  << webcam->getBufferAllocationCount() << " frame buffer(s)" << std::endl;
         webcam->release();
     }
+    if (depthEstimator) {
+        std::cout << "Depth ran on " << depthEstimator->getCompletedCount() << " frame(s), skipped "
+                  << depthEstimator->getCancelledCount() << " stale frame(s)" << std::endl;
+        std::cout << depthGate->summary() << std::endl;
+        if (depthQuality) {
+            std::cout << depthQuality->summary() << std::endl;
+        }
+        if (AllocationCounter::isInstalled()) {
+            std::cout << "Depth estimation allocated " << depthEstimator->getLastFrameAllocationCount()
+                      << " Mat buffer(s) on its last frame (all threads, other heap allocations not counted)" << std::endl;
+        }
+    }
+    std::cout << CoreBudget::cpuTimeSummary() << std::endl;
     glDeleteTextures(1, &textureID);
     glfwTerminate();
     
@@ -0,0 +1,137 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include "WebcamFactory.h"
+#include "DepthEstimatorPool.h"
+#include "StreamManager.h"
+#include "CoreBudget.h"
+#include "FrameContext.h"
+#include "TaskScheduler.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " <source> [<source> ...] [options]" << std::endl;
+    std::cout << "  Sources: camera | camera:yuv | video:<file> | images:<dir> | synthetic[:WxH]" << std::endl;
+    std::cout << "  --workers N     Processing threads (default: one per core)" << std::endl;
+    std::cout << "  --task-threads N  Threads of the scheduler every stream's stages share (default: one per inference core)" << std::endl;
+    std::cout << "  --estimators M  Depth estimators shared by all streams (default: 1)" << std::endl;
+    std::cout << "  --batch B       Frames from different streams per depth pass (default: 1)" << std::endl;
+    std::cout << "  --seconds S     Run time before exiting (default: 10)" << std::endl;
+    std::cout << "  --edge --face --depth  Effects to run on every stream" << std::endl;
+    std::cout << "  --fast          Read replayed sources as fast as possible" << std::endl;
+    std::cout << "  --cores SPEC    auto, or inference=CPUS (e.g. 2-7) to pin workers and DNN threads" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> sourceSpecs;
+    size_t workerCount = 0;
+    size_t taskThreads = 0;
+    size_t estimatorCount = 1;
+    size_t batchSize = 1;
+    double runSeconds = 10.0;
+    bool edge = false;
+    bool face = false;
+    bool depth = false;
+    bool realTime = true;
+    std::string coreSpec;
+    
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workerCount = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--task-threads") == 0 && i + 1 < argc) {
+            taskThreads = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--estimators") == 0 && i + 1 < argc) {
+            estimatorCount = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batchSize = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            runSeconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--edge") == 0) {
+            edge = true;
+        } else if (std::strcmp(argv[i], "--face") == 0) {
+            face = true;
+        } else if (std::strcmp(argv[i], "--depth") == 0) {
+            depth = true;
+        } else if (std::strcmp(argv[i], "--cores") == 0 && i + 1 < argc) {
+            coreSpec = argv[++i];
+        } else if (std::strcmp(argv[i], "--fast") == 0) {
+            realTime = false;
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            sourceSpecs.push_back(argv[i]);
+        }
+    }
+    
+    if (sourceSpecs.empty()) {
+        printUsage(argv[0]);
+        return -1;
+    }
+    
+    std::cout << "=== Multi-Stream Demo ===" << std::endl;
+    
+    // Split the cores before any worker threads start
+    if (!coreSpec.empty() && !CoreBudget::configure(coreSpec)) {
+        std::cout << "Continuing without a core budget" << std::endl;
+    }
+    TaskScheduler::setWorkerCount(taskThreads);
+    
+    StreamManager manager;
+    manager.setEdgeDetection(edge);
+    manager.setFaceDetection(face);
+    manager.setDepthEstimation(depth);
+    manager.setDepthBatchSize(batchSize);
+    
+    for (const std::string& spec : sourceSpecs) {
+        std::unique_ptr<IWebcamCapture> source = WebcamFactory::createFromSpec(spec, realTime);
+        if (!source) {
+            std::cerr << "❌ Error: Could not open source " << spec << std::endl;
+            continue;
+        }
+        manager.addStream(std::move(source), spec);
+    }
+    
+    if (manager.getStreamCount() == 0) {
+        std::cerr << "❌ Error: No sources could be opened" << std::endl;
+        return -1;
+    }
+    
+    // One model load per estimator, however many streams there are
+    DepthEstimatorPool depthPool;
+    if (depth && !depthPool.initialize(estimatorCount)) {
+        std::cerr << "❌ Error: Could not initialize depth estimation, continuing without it" << std::endl;
+        manager.setDepthEstimation(false);
+    }
+    
+    // Workers and OpenCV's threads share the inference cores
+    CoreBudget::applyInferenceThreads();
+    
+    if (!manager.start(workerCount, depth ? &depthPool : nullptr)) {
+        std::cerr << "❌ Error: Could not start stream processing" << std::endl;
+        return -1;
+    }
+    
+    // Report periodically until the run time is up
+    auto runStart = std::chrono::steady_clock::now();
+    auto nextReport = runStart + std::chrono::seconds(2);
+    while (std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count() < runSeconds) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (std::chrono::steady_clock::now() >= nextReport) {
+            std::cout << manager.statsSummary() << std::endl;
+            nextReport += std::chrono::seconds(2);
+        }
+    }
+    
+    manager.stop();
+    
+    std::cout << "Final throughput:" << std::endl;
+    std::cout << manager.statsSummary() << std::endl;
+    std::cout << FrameContext::summary() << std::endl;
+    std::cout << TaskScheduler::shared().summary() << std::endl;
+    std::cout << CoreBudget::cpuTimeSummary() << std::endl;
+    std::cout << "✅ Multi-stream demo completed successfully!" << std::endl;
+    return 0;
+}